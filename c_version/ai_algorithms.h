@@ -4,6 +4,7 @@
  * - DFS (Depth-First Search)
  * - Min-Max avec Alpha-Beta Pruning
  * - Iterative Deepening DFS
+ * - Monte Carlo Tree Search (UCT parallèle)
  */
 
 #ifndef AI_ALGORITHMS_H
@@ -11,63 +12,238 @@
 
 #include "game_rules.h"
 #include "game_engine.h"
+#include "eval_weights.h"
+#include "move.h"
+#include "nnue.h"
+#include "notation.h"
+#include "playout.h"
+#include "profiler.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
 #include <vector>
-#include <tuple>
+#include <string>
+#include <sstream>
 #include <optional>
-#include <queue>
 #include <limits>
 #include <cmath>
 #include <chrono>
+#include <thread>
+#include <mutex>
+#include <type_traits>
+
+// Caractéristiques de l'évaluation (différences joueur - adversaire), pondérées par EVAL_WEIGHTS
+// Les caractéristiques du plateau sont lues dans GameState::features, tenu à jour par le moteur
+enum EvalFeature
+{
+    EVAL_CAPTURED,          // graines capturées
+    EVAL_BOARD,             // graines dans ses trous
+    EVAL_VULNERABLE,        // trous à 1-2 graines dans son camp (capturables au prochain semis)
+    EVAL_EMPTY,             // trous vides dans son camp
+    EVAL_TRANSPARENT,       // graines transparentes dans son camp
+    EVAL_TRANSPARENT_HOLES, // trous de son camp d'où jouer TR/TB
+    EVAL_MOBILITY,          // coups légaux
+    EVAL_NEAR_WIN,          // graines capturées au-delà de 40 (à moins de 9 de la victoire à 49)
+    EVAL_DRAW_LINE,         // 40 graines capturées ou plus (seuil d'égalité 40-40)
+    EVAL_FEATURE_COUNT
+};
+
+static_assert(sizeof(EVAL_WEIGHTS) / sizeof(EVAL_WEIGHTS[0]) == EVAL_FEATURE_COUNT,
+              "eval_weights.h: un poids par caractéristique (régénérer avec tune_eval)");
+
+// Lot de positions en structure de tableaux pour l'évaluation vectorisée
+struct EvalBatch
+{
+    static constexpr int CAPACITY = 32; // nombre maximal de coups depuis une position
+
+    // Rangement par caractéristique: features[f][k] = caractéristique f de la position k, vue du joueur 1
+    alignas(32) int16_t features[EVAL_FEATURE_COUNT][CAPACITY];
+    int size;
+
+    EvalBatch() : features{}, size(0) {}
+
+    bool full() const { return size == CAPACITY; }
+    void clear() { size = 0; }
+
+    int push(const GameState &state);
+};
 
 class Evaluator
 {
 public:
     /**Évalue la qualité d'une position - Optimized*/
+    const NnueNetwork *network = nullptr; // réseau (nnue.h) si défini, sinon poids de eval_weights.h
+
+    static void features(const GameState &state, int player, int *f)
+    {
+        /**
+        Caractéristiques de la position du point de vue de player (voir EvalFeature)
+        Toutes sont des différences: celles de l'adversaire sont leurs opposées
+        */
+        player == 1 ? features<1>(state, f) : features<2>(state, f);
+    }
+
+    template <int Player, class Rules>
+    static void features(const BasicGameState<Rules> &state, int *f)
+    {
+        /**
+        features() pour un joueur fixé à la compilation: indices des deux camps constants
+        Seuils de fin (EVAL_NEAR_WIN, EVAL_DRAW_LINE) de la variante: 40 en standard
+        */
+        constexpr int draw = Rules::DRAW_THRESHOLD;
+        const BoardFeatures &board = state.features;
+        constexpr int own = Player - 1;
+        constexpr int opp = 2 - Player;
+        int cp = state.captured_seeds[Player];
+        int co = state.captured_seeds[3 - Player];
+
+        f[EVAL_CAPTURED] = cp - co;
+        f[EVAL_BOARD] = board.seeds[own] - board.seeds[opp];
+        f[EVAL_VULNERABLE] = board.vulnerable[own] - board.vulnerable[opp];
+        f[EVAL_EMPTY] = board.empty[own] - board.empty[opp];
+        f[EVAL_TRANSPARENT] = board.transparent[own] - board.transparent[opp];
+        f[EVAL_TRANSPARENT_HOLES] = board.transparent_holes[own] - board.transparent_holes[opp];
+        f[EVAL_MOBILITY] = board.mobility[own] - board.mobility[opp];
+        f[EVAL_NEAR_WIN] = std::max(0, cp - draw) - std::max(0, co - draw);
+        f[EVAL_DRAW_LINE] = static_cast<int>(cp >= draw) - static_cast<int>(co >= draw);
+    }
 
-    static double evaluate(const GameState &state, int player)
+    double evaluate(const GameState &state, int player) const
     {
         /**
         Évalue une position pour un joueur - Optimized
         Score positif = avantage pour le joueur
         */
-        int opponent = 3 - player;
-        const auto &captured = state.captured_seeds;
-        const auto &holes = state.holes;
+        return network ? network->evaluate(state, player) : evaluateWeights(state, player);
+    }
+
+    template <int Player, class Rules>
+    double evaluate(const BasicGameState<Rules> &state) const
+    {
+        /**
+        evaluate() pour un joueur fixé à la compilation (noyau de MinMaxBot)
+        Le réseau ne connaît que le plateau standard: une variante est évaluée par les poids
+        */
+        if constexpr (std::is_same<Rules, StandardRules>::value)
+        {
+            if (network)
+            {
+                return network->evaluate(state, Player);
+            }
+        }
+        return evaluateWeights<Player>(state);
+    }
 
-        // Différence de graines capturées
-        double score = (captured.at(player) - captured.at(opponent)) * 10.0;
+    static double evaluateWeights(const GameState &state, int player)
+    {
+        /**Somme pondérée des caractéristiques (poids entiers de eval_weights.h)*/
+        return player == 1 ? evaluateWeights<1>(state) : evaluateWeights<2>(state);
+    }
 
-        // Bonus pour les graines sur le plateau (inlined for speed)
-        int player_seeds = 0;
-        int opponent_seeds = 0;
+    template <int Player, class Rules>
+    static double evaluateWeights(const BasicGameState<Rules> &state)
+    {
+        PROFILE_ZONE(PROFILE_EVAL);
+        int f[EVAL_FEATURE_COUNT];
+        features<Player>(state, f);
+
+        int score = 0;
+        for (int k = 0; k < EVAL_FEATURE_COUNT; k++)
+        {
+            score += EVAL_WEIGHTS[k] * f[k];
+        }
+        return score;
+    }
 
-        const int *p_holes = (player == 1) ? PLAYER1_HOLES : PLAYER2_HOLES;
-        const int *o_holes = (player == 1) ? PLAYER2_HOLES : PLAYER1_HOLES;
+    static void evaluateBatch(const EvalBatch &batch, int player, double *scores)
+    {
+        /**
+        Même score que evaluateWeights() pour toutes les positions d'un lot
+        La boucle interne porte sur les positions (k), sans dépendance: elle est vectorisable.
+        Avec les options du README (-O2, GCC 12 et plus), SSE2: 4 positions int32 par instruction;
+        AVX2 (8 positions) seulement si l'on compile avec -mavx2 ou -march=native
+        */
+        PROFILE_ZONE(PROFILE_EVAL);
+        alignas(32) int32_t acc[EvalBatch::CAPACITY] = {};
+        for (int f = 0; f < EVAL_FEATURE_COUNT; f++)
+        {
+            const int16_t *values = batch.features[f];
+            for (int k = 0; k < EvalBatch::CAPACITY; k++)
+            {
+                acc[k] += values[k] * EVAL_WEIGHTS[f];
+            }
+        }
 
-        for (int i = 0; i < 8; i++)
+        // Le lot est vu du joueur 1: le score du joueur 2 est l'opposé
+        int sign = player == 1 ? 1 : -1;
+        for (int k = 0; k < batch.size; k++)
         {
-            const auto &h = holes.at(p_holes[i]);
-            player_seeds += h.at(Color::RED) + h.at(Color::BLUE) + h.at(Color::TRANSPARENT);
+            scores[k] = sign * acc[k];
         }
+    }
 
-        for (int i = 0; i < 8; i++)
+    void evaluateChildren(const GameState &state, const MoveList &moves,
+                          int player, double *scores) const
+    {
+        /**
+        Score de chaque enfant d'un nœud d'horizon (dans l'ordre des coups)
+        Enfants terminaux: getTerminalScore; les autres sont évalués en un seul lot,
+        ou par le réseau, l'accumulateur de chaque enfant étant déduit de celui du parent
+        */
+        if (network)
         {
-            const auto &h = holes.at(o_holes[i]);
-            opponent_seeds += h.at(Color::RED) + h.at(Color::BLUE) + h.at(Color::TRANSPARENT);
+            NnueAccumulator parent, child_acc;
+            network->refresh(state, parent);
+            int sign = player == 1 ? 1 : -1;
+            for (size_t i = 0; i < moves.size(); i++)
+            {
+                GameState child = MoveGenerator::applyMove(state, moves[i]);
+                if (isTerminal(child))
+                {
+                    scores[i] = getTerminalScore(child, player);
+                    continue;
+                }
+                network->update(state, child, parent, child_acc);
+                scores[i] = sign * network->output(child_acc);
+            }
+            return;
         }
 
-        score += (player_seeds - opponent_seeds) * 2.0;
+        EvalBatch batch;
+        int slot[EvalBatch::CAPACITY];
+        double batch_scores[EvalBatch::CAPACITY];
+        int n = static_cast<int>(moves.size());
 
-        return score;
+        for (int i = 0; i < n; i++)
+        {
+            GameState child = MoveGenerator::applyMove(state, moves[i]);
+            if (isTerminal(child))
+            {
+                scores[i] = getTerminalScore(child, player);
+            }
+            else
+            {
+                slot[batch.push(child)] = i;
+            }
+        }
+
+        evaluateBatch(batch, player, batch_scores);
+        for (int k = 0; k < batch.size; k++)
+        {
+            scores[slot[k]] = batch_scores[k];
+        }
     }
 
-    static bool isTerminal(const GameState &state)
+    template <class Rules>
+    static bool isTerminal(const BasicGameState<Rules> &state)
     {
         /**Vérifie si c'est un état terminal*/
         return state.isGameOver();
     }
 
-    static double getTerminalScore(const GameState &state, int player)
+    template <class Rules>
+    static double getTerminalScore(const BasicGameState<Rules> &state, int player)
     {
         /**Retourne le score d'un état terminal - Optimized*/
         int cp = state.captured_seeds.at(player);
@@ -85,29 +261,58 @@ public:
             return 0.0; // Égalité
         }
     }
+
+    template <int Player, class Rules>
+    static double terminalScore(const BasicGameState<Rules> &state)
+    {
+        /**getTerminalScore() pour un joueur fixé à la compilation*/
+        int diff = state.captured_seeds[Player] - state.captured_seeds[3 - Player];
+        return diff > 0 ? std::numeric_limits<double>::infinity()
+                        : diff < 0 ? -std::numeric_limits<double>::infinity() : 0.0;
+    }
 };
 
-// Structure pour représenter un coup
-struct Move
+inline int EvalBatch::push(const GameState &state)
 {
-    int hole;
-    Color color;
-    Color transparent_as;
-    bool use_transparent;
-    bool valid;
-
-    Move() : hole(-1), color(Color::RED), transparent_as(Color::RED), use_transparent(false), valid(false) {}
-    Move(int h, Color c, Color t, bool ut) : hole(h), color(c), transparent_as(t), use_transparent(ut), valid(true) {}
-};
+    /**Ajoute une position au lot et retourne son indice*/
+    int k = size++;
+    int f[EVAL_FEATURE_COUNT];
+    Evaluator::features(state, 1, f);
+    for (int j = 0; j < EVAL_FEATURE_COUNT; j++)
+    {
+        features[j][k] = static_cast<int16_t>(f[j]);
+    }
+    return k;
+}
 
 class BFSBot
 {
 public:
-    /**Algorithme BFS pour explorer les états à profondeur égale*/
+    /**
+    Recherche en largeur niveau par niveau, jusqu'à une profondeur donnée
+    - Chaque niveau est un tableau de positions compactes (PackedPosition, 32 octets)
+    - Les transpositions d'un même niveau sont fusionnées (hachage de la forme compacte):
+      les niveaux forment un graphe, chaque position n'y est développée qu'une fois
+    - Développement, fusion et évaluation répartis sur les threads d'un ThreadPool gardé
+      d'une recherche à l'autre; le résultat ne dépend pas du nombre de threads
+    - Mémoire bornée (memory_mb): un niveau qui dépasserait la borne n'est pas construit,
+      la recherche s'arrête au dernier niveau complet
+    - Valeurs remontées par minimax des feuilles vers la racine: même score que
+      MinMaxBot à profondeur fixe. Avec un réseau, l'accumulateur d'une feuille du dernier
+      niveau est déduit de celui de son parent (NnueNetwork::update)
+    */
     int depth;
+    int threads;   // 0: un par cœur
+    int memory_mb; // mémoire maximale des niveaux
     Evaluator evaluator;
 
-    BFSBot(int d = 2) : depth(d) {}
+    // Dernière recherche
+    int depth_reached = 0;
+    double score = 0.0;
+    long nodes = 0;      // positions distinctes, tous niveaux
+    long duplicates = 0; // transpositions fusionnées
+
+    BFSBot(int d = 2, int thread_count = 0, int memory = 256) : depth(d), threads(thread_count), memory_mb(memory) {}
 
     Move search(const GameState &state, int player)
     {
@@ -115,67 +320,464 @@ public:
         Effectue une recherche BFS jusqu'à une profondeur donnée
         Retourne le meilleur coup
         */
-        if (evaluator.isTerminal(state))
+        depth_reached = 0;
+        score = 0.0;
+        nodes = 0;
+        duplicates = 0;
+
+        GameState root = state.copy();
+        root.current_player = player;
+        if (evaluator.isTerminal(root))
+        {
+            return Move();
+        }
+        MoveList root_moves = MoveGenerator::getAllMoves(root, player);
+        if (root_moves.empty())
         {
             return Move();
         }
 
-        // Queue: (state, depth, first_move)
-        struct QueueItem
+        std::vector<Level> levels(1);
+        levels[0].nodes.resize(1);
+        if (!store(root, levels[0].nodes[0]))
         {
-            GameState state;
-            int depth;
-            Move first_move;
-        };
-        std::queue<QueueItem> queue;
-        queue.push({state, 0, Move()});
+            return root_moves[0];
+        }
 
-        Move best_move;
-        double best_score = -std::numeric_limits<double>::infinity();
+        int workers = threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency());
+        workers = std::max(1, workers);
+        if (workers > 1 && (!pool || pool->size() != workers))
+        {
+            pool = std::make_unique<ThreadPool>(workers);
+        }
+        size_t budget = static_cast<size_t>(std::max(1, memory_mb)) << 20;
+        size_t used = Level::BYTES_PER_NODE;
+
+        for (int d = 0; d < depth; d++)
+        {
+            int side = d % 2 == 0 ? player : 3 - player;
+            if (!expand(levels, side, workers, budget, used))
+            {
+                break;
+            }
+        }
+        depth_reached = static_cast<int>(levels.size()) - 1;
+        for (const Level &level : levels)
+        {
+            nodes += static_cast<long>(level.nodes.size());
+        }
+
+        // Minimax du dernier niveau vers la racine
+        int last = depth_reached;
+        if (evaluator.network && last > 0)
+        {
+            evaluateLeaves(levels, player, workers);
+            last--;
+        }
+        for (int d = last; d >= 0; d--)
+        {
+            backup(levels, d, player, workers);
+        }
+
+        const Level &top = levels[0];
+        if (top.edges.empty())
+        {
+            return root_moves[0];
+        }
+        const std::vector<double> &children = levels[1].values;
+        int best = 0;
+        for (uint32_t e = 1; e < top.edges.size(); e++)
+        {
+            if (children[top.edges[e]] > children[top.edges[best]])
+            {
+                best = static_cast<int>(e);
+            }
+        }
+        score = top.values[0];
+        return root_moves[best];
+    }
+
+    Move getMove(const GameState &state, int player)
+    {
+        /**Interface publique pour obtenir un coup*/
+        return search(state, player);
+    }
+
+private:
+    std::unique_ptr<ThreadPool> pool; // threads > 1 seulement
+
+    struct Level
+    {
+        std::vector<PackedPosition> nodes;
+        std::vector<uint32_t> first_edge; // arêtes de nodes[i]: [first_edge[i], first_edge[i + 1])
+        std::vector<uint32_t> edges;      // indice de l'enfant au niveau suivant, dans l'ordre des coups
+        std::vector<double> values;
+
+        static constexpr size_t BYTES_PER_NODE = sizeof(PackedPosition) + sizeof(uint32_t) + sizeof(double);
+    };
+
+    struct Child
+    {
+        PackedPosition position;
+        uint64_t hash;
+    };
+
+    // Coût d'un enfant pendant la construction d'un niveau: enfant brut, indice canonique,
+    // rang dans les partitions, deux cases de table de fusion (taille exacte 2 x partition),
+    // arête et nœud conservés
+    static constexpr size_t BYTES_PER_CHILD = sizeof(Child) + sizeof(uint32_t) + sizeof(uint32_t) +
+                                              2 * sizeof(uint32_t) + sizeof(uint32_t) + Level::BYTES_PER_NODE;
+
+    template <class Task>
+    void parallelFor(int tasks, const Task &task) const
+    {
+        /**task(t) pour t = 0..tasks-1 sur le pool (sur le thread appelant s'il n'y a qu'une tâche)*/
+        if (!pool || tasks <= 1)
+        {
+            for (int t = 0; t < tasks; t++)
+            {
+                task(t);
+            }
+            return;
+        }
+        for (int t = 0; t < tasks; t++)
+        {
+            pool->submit([&task, t]() { task(t); });
+        }
+        pool->wait();
+    }
+
+    static size_t rangeBegin(size_t count, int tasks, int t)
+    {
+        /**Découpage de [0, count) en tranches contiguës, une par tâche*/
+        return count * static_cast<size_t>(t) / static_cast<size_t>(tasks);
+    }
 
-        while (!queue.empty())
+    static uint64_t hash(const PackedPosition &position)
+    {
+        uint64_t h = 0x9E3779B97F4A7C15ULL;
+        for (int k = 0; k < 4; k++)
         {
-            QueueItem item = queue.front();
-            queue.pop();
+            uint64_t word;
+            std::memcpy(&word, position.bytes + 8 * k, sizeof(word));
+            h = (h ^ word) * 0xFF51AFD7ED558CCDULL;
+            h ^= h >> 32;
+        }
+        return h;
+    }
+
+    static constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
 
-            // Si on a atteint la profondeur désirée
-            if (item.depth == depth)
+    static int partition(uint64_t h, int tasks)
+    {
+        /**Bits de poids fort: indépendants de la case (32 bits de poids faible) dans la table*/
+        return static_cast<int>((h >> 40) % static_cast<uint64_t>(tasks));
+    }
+
+    static bool store(GameState state, PackedPosition &position)
+    {
+        /**
+        Forme compacte d'une position d'un niveau: le trait y suit la parité du nombre de coups,
+        celui du niveau est rétabli par load() (la racine n'est pas forcément à la parité des coups)
+        */
+        state.current_player = 1 + (state.move_count & 1);
+        return Notation::pack(state, position);
+    }
+
+    static bool load(const PackedPosition &position, int side, GameState &state)
+    {
+        /**Position d'un niveau, avec le trait du niveau*/
+        if (!Notation::unpack(position, state))
+        {
+            return false;
+        }
+        state.current_player = side;
+        return true;
+    }
+
+    bool expand(std::vector<Level> &levels, int side, int workers, size_t budget, size_t &used)
+    {
+        /**
+        Construit le niveau suivant le dernier de levels
+        false (levels inchangé) si le niveau dépasserait la mémoire ou si un enfant n'est pas représentable
+        */
+        Level &parent = levels.back();
+        size_t count = parent.nodes.size();
+        int tasks = static_cast<int>(std::min<size_t>(static_cast<size_t>(workers), count));
+
+        // 1. Nombre de coups de chaque parent (aucun pour une position terminale)
+        std::vector<uint32_t> first_edge(count + 1, 0);
+        parallelFor(tasks, [&](int t)
+        {
+            GameState state;
+            for (size_t i = rangeBegin(count, tasks, t); i < rangeBegin(count, tasks, t + 1); i++)
             {
-                double score = evaluator.evaluate(item.state, player);
-                if (score > best_score && item.first_move.valid)
+                if (load(parent.nodes[i], side, state) && !state.isGameOver())
                 {
-                    best_score = score;
-                    best_move = item.first_move;
+                    first_edge[i + 1] = static_cast<uint32_t>(MoveGenerator::getAllMoves(state, side).size());
                 }
-                continue;
             }
-
-            // Explorer les enfants
-            if (item.state.current_player == player)
+        });
+        size_t total = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            total += first_edge[i + 1];
+            if (total > std::numeric_limits<uint32_t>::max() / 2)
             {
-                auto next_moves = MoveGenerator::getAllMoves(item.state, player);
+                return false;
+            }
+            first_edge[i + 1] = static_cast<uint32_t>(total);
+        }
+        size_t edge_bytes = count * sizeof(uint32_t) + sizeof(uint32_t);
+        if (total == 0 || used + edge_bytes + total * BYTES_PER_CHILD > budget)
+        {
+            return false;
+        }
 
-                for (const auto &move : next_moves)
+        // 2. Enfants bruts, rangés à la place de leur arête: l'ordre ne dépend pas du découpage
+        std::vector<Child> children(total);
+        std::vector<char> failed(tasks, 0);
+        parallelFor(tasks, [&](int t)
+        {
+            GameState state;
+            for (size_t i = rangeBegin(count, tasks, t); i < rangeBegin(count, tasks, t + 1) && !failed[t]; i++)
+            {
+                if (first_edge[i] == first_edge[i + 1] || !load(parent.nodes[i], side, state))
+                {
+                    continue;
+                }
+                size_t e = first_edge[i];
+                for (Move move : MoveGenerator::getAllMoves(state, side))
                 {
-                    int hole = std::get<0>(move);
-                    Color color = std::get<1>(move);
-                    Color trans_as = std::get<2>(move);
-                    bool use_trans = std::get<3>(move);
+                    Child &child = children[e++];
+                    if (!store(MoveGenerator::applyMove(state, move), child.position))
+                    {
+                        failed[t] = 1;
+                        break;
+                    }
+                    child.hash = hash(child.position);
+                }
+            }
+        });
+        if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+        {
+            return false;
+        }
 
-                    GameState new_state = MoveGenerator::applyMove(item.state, hole, color, trans_as, use_trans);
-                    Move first = item.first_move.valid ? item.first_move : Move(hole, color, trans_as, use_trans);
-                    queue.push({new_state, item.depth + 1, first});
+        // 3. Fusion des transpositions: tri par dénombrement des arêtes selon la partition du
+        //    hachage (une passe), puis chaque tâche ne parcourt que sa partition;
+        //    canon[e] = première arête menant à la même position
+        std::vector<size_t> counts(static_cast<size_t>(tasks) * tasks, 0); // [tranche][partition]
+        parallelFor(tasks, [&](int t)
+        {
+            for (size_t e = rangeBegin(total, tasks, t); e < rangeBegin(total, tasks, t + 1); e++)
+            {
+                counts[t * tasks + partition(children[e].hash, tasks)]++;
+            }
+        });
+        std::vector<size_t> bucket(tasks + 1, 0);
+        size_t offset = 0;
+        for (int part = 0; part < tasks; part++)
+        {
+            bucket[part] = offset;
+            for (int t = 0; t < tasks; t++)
+            {
+                size_t n = counts[t * tasks + part];
+                counts[t * tasks + part] = offset; // début de la tranche t dans la partition
+                offset += n;
+            }
+        }
+        bucket[tasks] = offset;
+
+        // Tranches rangées dans l'ordre: chaque partition garde les arêtes par indice croissant
+        std::vector<uint32_t> order(total);
+        parallelFor(tasks, [&](int t)
+        {
+            for (size_t e = rangeBegin(total, tasks, t); e < rangeBegin(total, tasks, t + 1); e++)
+            {
+                order[counts[t * tasks + partition(children[e].hash, tasks)]++] = static_cast<uint32_t>(e);
+            }
+        });
+
+        std::vector<uint32_t> canon(total);
+        parallelFor(tasks, [&](int t)
+        {
+            // Table de taille exacte 2 x partition (facteur de charge 1/2, comme compté dans BYTES_PER_CHILD)
+            size_t size = 2 * (bucket[t + 1] - bucket[t]);
+            std::vector<uint32_t> table(size, EMPTY_SLOT);
+            for (size_t k = bucket[t]; k < bucket[t + 1]; k++)
+            {
+                uint32_t e = order[k];
+                const Child &child = children[e];
+                size_t slot = static_cast<size_t>(((child.hash & 0xFFFFFFFFULL) * size) >> 32);
+                while (table[slot] != EMPTY_SLOT &&
+                       !(children[table[slot]].hash == child.hash && children[table[slot]].position == child.position))
+                {
+                    slot = slot + 1 == size ? 0 : slot + 1;
+                }
+                if (table[slot] == EMPTY_SLOT)
+                {
+                    table[slot] = e;
                 }
+                canon[e] = table[slot];
+            }
+        });
+
+        // 4. Niveau compact: une position par classe, arêtes réécrites en indices du niveau
+        Level next;
+        for (uint32_t e = 0; e < total; e++)
+        {
+            if (canon[e] == e)
+            {
+                canon[e] = static_cast<uint32_t>(next.nodes.size());
+                next.nodes.push_back(children[e].position);
+            }
+            else
+            {
+                canon[e] = canon[canon[e]]; // canon[e] < e: déjà réécrit
             }
         }
+        next.nodes.shrink_to_fit();
+        duplicates += static_cast<long>(total - next.nodes.size());
+
+        parent.first_edge = std::move(first_edge);
+        parent.edges = std::move(canon);
+        used += edge_bytes + total * sizeof(uint32_t) + next.nodes.size() * Level::BYTES_PER_NODE;
+        levels.push_back(std::move(next));
+        return true;
+    }
 
-        return best_move;
+    void evaluateLeaves(std::vector<Level> &levels, int player, int workers) const
+    {
+        /**
+        Valeurs du dernier niveau avec un réseau, parent par parent: l'accumulateur du parent
+        est calculé une fois, celui de chaque enfant en est déduit (NnueNetwork::update)
+        Un enfant est évalué depuis sa première arête: les premières occurrences sont rangées
+        par indice croissant, une arête e mène à un nouvel enfant si edges[e] == nombre déjà vu
+        */
+        int d = static_cast<int>(levels.size()) - 1;
+        const Level &parent = levels[d - 1];
+        Level &level = levels[d];
+        int parent_side = (d - 1) % 2 == 0 ? player : 3 - player;
+        int side = 3 - parent_side;
+        int sign = player == 1 ? 1 : -1;
+        size_t count = parent.nodes.size();
+        int tasks = static_cast<int>(std::min<size_t>(static_cast<size_t>(workers), count));
+        level.values.assign(level.nodes.size(), 0.0);
+
+        // Enfants déjà vus avant la tranche de chaque tâche
+        std::vector<uint32_t> seen(tasks, 0);
+        uint32_t distinct = 0;
+        for (int t = 0; t < tasks; t++)
+        {
+            seen[t] = distinct;
+            uint32_t end = parent.first_edge[rangeBegin(count, tasks, t + 1)];
+            for (uint32_t e = parent.first_edge[rangeBegin(count, tasks, t)]; e < end; e++)
+            {
+                distinct = std::max(distinct, parent.edges[e] + 1);
+            }
+        }
+
+        parallelFor(tasks, [&](int t)
+        {
+            GameState from, state;
+            NnueAccumulator from_acc, acc;
+            uint32_t next = seen[t];
+            for (size_t i = rangeBegin(count, tasks, t); i < rangeBegin(count, tasks, t + 1); i++)
+            {
+                bool loaded = false;
+                for (uint32_t e = parent.first_edge[i]; e < parent.first_edge[i + 1]; e++)
+                {
+                    uint32_t c = parent.edges[e];
+                    if (c != next)
+                    {
+                        continue; // déjà évalué depuis une arête précédente
+                    }
+                    next++;
+                    load(level.nodes[c], side, state);
+                    if (evaluator.isTerminal(state))
+                    {
+                        level.values[c] = Evaluator::getTerminalScore(state, player);
+                        continue;
+                    }
+                    if (!loaded)
+                    {
+                        load(parent.nodes[i], parent_side, from);
+                        evaluator.network->refresh(from, from_acc);
+                        loaded = true;
+                    }
+                    evaluator.network->update(from, state, from_acc, acc);
+                    level.values[c] = sign * evaluator.network->output(acc);
+                }
+            }
+        });
     }
 
-    Move getMove(const GameState &state, int player)
+    void backup(std::vector<Level> &levels, int d, int player, int workers) const
     {
-        /**Interface publique pour obtenir un coup*/
-        return search(state, player);
+        /**
+        Valeurs du niveau d, vues de player: maximum des enfants si player a le trait, minimum sinon
+        Feuilles (dernier niveau, positions terminales ou sans coup): évaluation, par lots hors réseau
+        */
+        Level &level = levels[d];
+        const std::vector<double> *children = d + 1 < static_cast<int>(levels.size()) ? &levels[d + 1].values : nullptr;
+        int side = d % 2 == 0 ? player : 3 - player;
+        bool maximizing = side == player;
+        size_t count = level.nodes.size();
+        int tasks = static_cast<int>(std::min<size_t>(static_cast<size_t>(workers), count));
+        level.values.assign(count, 0.0);
+
+        parallelFor(tasks, [&](int t)
+        {
+            GameState state;
+            EvalBatch batch;
+            size_t slot[EvalBatch::CAPACITY];
+            double batch_scores[EvalBatch::CAPACITY];
+            auto flush = [&]()
+            {
+                evaluator.evaluateBatch(batch, player, batch_scores);
+                for (int k = 0; k < batch.size; k++)
+                {
+                    level.values[slot[k]] = batch_scores[k];
+                }
+                batch.clear();
+            };
+
+            for (size_t i = rangeBegin(count, tasks, t); i < rangeBegin(count, tasks, t + 1); i++)
+            {
+                if (children && level.first_edge[i] != level.first_edge[i + 1])
+                {
+                    double best = (*children)[level.edges[level.first_edge[i]]];
+                    for (uint32_t e = level.first_edge[i] + 1; e < level.first_edge[i + 1]; e++)
+                    {
+                        double value = (*children)[level.edges[e]];
+                        best = maximizing ? std::max(best, value) : std::min(best, value);
+                    }
+                    level.values[i] = best;
+                    continue;
+                }
+
+                load(level.nodes[i], side, state);
+                if (evaluator.isTerminal(state))
+                {
+                    level.values[i] = Evaluator::getTerminalScore(state, player);
+                }
+                else if (evaluator.network)
+                {
+                    // Sans coup avant le dernier niveau (rare): accumulateur recalculé
+                    level.values[i] = evaluator.evaluate(state, player);
+                }
+                else
+                {
+                    slot[batch.push(state)] = i;
+                    if (batch.full())
+                    {
+                        flush();
+                    }
+                }
+            }
+            flush();
+        });
     }
 };
 
@@ -227,20 +829,32 @@ public:
             best_score = -std::numeric_limits<double>::infinity();
             auto moves = MoveGenerator::getAllMoves(state, player);
 
-            for (const auto &move : moves)
+            // Enfants à l'horizon: évalués en un seul lot
+            double leaf_scores[EvalBatch::CAPACITY];
+            bool horizon = current_depth + 1 >= depth;
+            if (horizon)
             {
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
+                evaluator.evaluateChildren(state, moves, player, leaf_scores);
+            }
 
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
-                auto [score, _] = search(new_state, player, current_depth + 1);
+            for (size_t i = 0; i < moves.size(); i++)
+            {
+                Move move = moves[i];
+                double score;
+                if (horizon)
+                {
+                    score = leaf_scores[i];
+                }
+                else
+                {
+                    GameState new_state = MoveGenerator::applyMove(state, move);
+                    score = search(new_state, player, current_depth + 1).first;
+                }
 
                 if (score > best_score)
                 {
                     best_score = score;
-                    best_move = Move(hole, color, trans_as, use_trans);
+                    best_move = move;
                 }
             }
         }
@@ -251,20 +865,32 @@ public:
             best_score = std::numeric_limits<double>::infinity();
             auto moves = MoveGenerator::getAllMoves(state, opponent);
 
-            for (const auto &move : moves)
+            // Enfants à l'horizon: évalués en un seul lot
+            double leaf_scores[EvalBatch::CAPACITY];
+            bool horizon = current_depth + 1 >= depth;
+            if (horizon)
             {
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
+                evaluator.evaluateChildren(state, moves, player, leaf_scores);
+            }
 
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
-                auto [score, _] = search(new_state, player, current_depth + 1);
+            for (size_t i = 0; i < moves.size(); i++)
+            {
+                Move move = moves[i];
+                double score;
+                if (horizon)
+                {
+                    score = leaf_scores[i];
+                }
+                else
+                {
+                    GameState new_state = MoveGenerator::applyMove(state, move);
+                    score = search(new_state, player, current_depth + 1).first;
+                }
 
                 if (score < best_score)
                 {
                     best_score = score;
-                    best_move = Move(hole, color, trans_as, use_trans);
+                    best_move = move;
                 }
             }
         }
@@ -280,10 +906,207 @@ public:
     }
 };
 
-class MinMaxBot
+struct SearchIteration
+{
+    int depth;
+    long nodes;
+    long time_us;
+    bool completed; // false si l'itération a été interrompue par le timeout
+};
+
+struct SearchStats
+{
+    /**
+    Télémétrie d'une recherche (un enregistrement par coup joué)
+    - Profondeur atteinte, nœuds, NPS, temps par itération
+    - Facteur de branchement effectif (rapport des deux dernières itérations complètes)
+    - Taux de coupure au premier coup (qualité de l'ordre des coups)
+    - Taux de réussite de la table de transposition (MinMaxBot avec setHashSize > 0)
+    - Part de quiescence: reste à 0 tant que la recherche n'a pas de quiescence
+    */
+    int depth_reached = 0;
+    double score = 0.0; // évaluation du coup retenu (dernière itération complète)
+    long nodes = 0;
+    long time_us = 0;
+    long cutoffs = 0;
+    long first_move_cutoffs = 0;
+    long tt_probes = 0;
+    long tt_hits = 0;
+    long quiescence_nodes = 0;
+    std::vector<SearchIteration> iterations;
+
+    void clear()
+    {
+        *this = SearchStats();
+    }
+
+    void recordCutoff(bool first_move)
+    {
+        cutoffs++;
+        if (first_move)
+        {
+            first_move_cutoffs++;
+        }
+    }
+
+    double nps() const
+    {
+        return time_us > 0 ? nodes * 1e6 / time_us : 0.0;
+    }
+
+    double branchingFactor() const
+    {
+        const SearchIteration *last = nullptr;
+        const SearchIteration *prev = nullptr;
+        for (const SearchIteration &it : iterations)
+        {
+            if (it.completed)
+            {
+                prev = last;
+                last = &it;
+            }
+        }
+        return (last && prev && prev->nodes > 0) ? static_cast<double>(last->nodes) / prev->nodes : 0.0;
+    }
+
+    double firstMoveCutoffRate() const
+    {
+        return cutoffs > 0 ? static_cast<double>(first_move_cutoffs) / cutoffs : 0.0;
+    }
+
+    double hashHitRate() const
+    {
+        return tt_probes > 0 ? static_cast<double>(tt_hits) / tt_probes : 0.0;
+    }
+
+    double quiescenceShare() const
+    {
+        return nodes > 0 ? static_cast<double>(quiescence_nodes) / nodes : 0.0;
+    }
+
+    std::string toJson(int ply, const std::string &move) const
+    {
+        /**Une ligne JSON (format JSON Lines) pour le journal des coups*/
+        std::ostringstream out;
+        out.setf(std::ios::fixed);
+        out.precision(3);
+        out << "{\"ply\":" << ply << ",\"move\":\"" << move << "\",\"depth\":" << depth_reached
+            << ",\"score\":" << score << ",\"nodes\":" << nodes << ",\"time_us\":" << time_us << ",\"nps\":" << static_cast<long>(nps())
+            << ",\"ebf\":" << branchingFactor() << ",\"first_move_cutoff_rate\":" << firstMoveCutoffRate()
+            << ",\"hash_hit_rate\":" << hashHitRate() << ",\"quiescence_share\":" << quiescenceShare()
+            << ",\"iterations\":[";
+        for (size_t i = 0; i < iterations.size(); i++)
+        {
+            const SearchIteration &it = iterations[i];
+            out << (i ? "," : "") << "{\"depth\":" << it.depth << ",\"nodes\":" << it.nodes
+                << ",\"time_us\":" << it.time_us << ",\"completed\":" << (it.completed ? "true" : "false") << "}";
+        }
+        out << "]}";
+        return out.str();
+    }
+};
+
+struct TTEntry
+{
+    uint64_t key;
+    float value;  // score pour le joueur de la recherche (exact pour les entiers et ±infini)
+    int8_t depth; // profondeur restante de la recherche qui a produit value
+    uint8_t bound;
+    uint8_t move; // code du meilleur coup, Move::NONE si aucun
+    uint8_t reserved;
+};
+
+static_assert(sizeof(TTEntry) == 16, "TTEntry: 16 octets");
+
+class TranspositionTable
 {
 public:
-    /**Algorithme Min-Max avec Alpha-Beta Pruning et timeout*/
+    /**
+    Table de transposition à une entrée par case, taille en puissance de deux
+    Remplacement: une autre position prend toujours la case, la même position
+    seulement à profondeur au moins égale
+    */
+    enum Bound : uint8_t
+    {
+        EMPTY = 0,
+        EXACT, // valeur exacte
+        LOWER, // valeur >= score (coupure beta)
+        UPPER  // valeur <= score (aucun coup n'a dépassé alpha)
+    };
+
+    void resize(int megabytes)
+    {
+        /**0 Mo: table désactivée*/
+        size_t count = 0;
+        if (megabytes > 0)
+        {
+            count = 1;
+            while (count * 2 * sizeof(TTEntry) <= static_cast<size_t>(megabytes) << 20)
+            {
+                count *= 2;
+            }
+        }
+        entries.assign(count, TTEntry{});
+        mask = count > 0 ? count - 1 : 0;
+    }
+
+    void clear() { std::fill(entries.begin(), entries.end(), TTEntry{}); }
+    bool enabled() const { return !entries.empty(); }
+
+    template <class Rules>
+    static uint64_t key(const BasicGameState<Rules> &state)
+    {
+        /**Hachage des compteurs (48 en standard), des captures, du trait et du nombre de coups*/
+        constexpr int words = sizeof(state.holes.seeds) / sizeof(uint64_t);
+        const uint8_t *counts = &state.holes.seeds[0][0];
+        uint64_t h = 0x9E3779B97F4A7C15ULL ^ (static_cast<uint64_t>(state.captured_seeds[1]) |
+                                              static_cast<uint64_t>(state.captured_seeds[2]) << 8 |
+                                              static_cast<uint64_t>(state.current_player) << 16 |
+                                              static_cast<uint64_t>(state.move_count) << 24);
+        for (int k = 0; k < words; k++)
+        {
+            uint64_t word;
+            std::memcpy(&word, counts + 8 * k, sizeof(word));
+            h = (h ^ word) * 0xFF51AFD7ED558CCDULL;
+            h ^= h >> 32;
+        }
+        return h;
+    }
+
+    const TTEntry *probe(uint64_t key) const
+    {
+        const TTEntry &entry = entries[key & mask];
+        return (entry.bound != EMPTY && entry.key == key) ? &entry : nullptr;
+    }
+
+    void store(uint64_t key, double value, int depth, Bound bound, Move move)
+    {
+        TTEntry &entry = entries[key & mask];
+        if (entry.key == key && entry.bound != EMPTY && entry.depth > depth)
+        {
+            return;
+        }
+        entry.key = key;
+        entry.value = static_cast<float>(value);
+        entry.depth = static_cast<int8_t>(depth);
+        entry.bound = bound;
+        entry.move = move.code;
+    }
+
+private:
+    std::vector<TTEntry> entries;
+    uint64_t mask = 0;
+};
+
+template <class Rules>
+class BasicMinMaxBot
+{
+public:
+    /**Algorithme Min-Max avec Alpha-Beta Pruning et timeout, pour les règles Rules (MinMaxBot: standard)*/
+    using State = BasicGameState<Rules>;
+    using Generator = BasicMoveGenerator<Rules>;
+    using MoveList = typename Generator::List;
+
     int depth;
     int max_depth;
     Evaluator evaluator;
@@ -291,111 +1114,196 @@ public:
     bool timeout_reached;
     std::chrono::steady_clock::time_point start_time;
     std::chrono::milliseconds timeout_ms;
+    SearchStats stats; // Télémétrie du dernier findBestMove
+    long node_limit;   // Budget de nœuds par coup (0: aucun), vérifié entre deux itérations
     static constexpr int CHECK_INTERVAL = 500; // Check timeout every N nodes
 
-    MinMaxBot(int d = 4) : depth(d), max_depth(20), nodes_explored(0), timeout_reached(false), timeout_ms(2000) {}
+    BasicMinMaxBot(int d = 4)
+        : depth(d), max_depth(20), nodes_explored(0), timeout_reached(false), timeout_ms(2000), node_limit(0) {}
 
-    double _minmax(const GameState &state, int current_depth, bool maximizing_player,
-                   int original_player, double alpha, double beta)
+    void setHashSize(int megabytes)
+    {
+        /**Taille de la table de transposition (0: sans table), conservée d'un coup à l'autre*/
+        tt.resize(megabytes);
+        tt_player = 0;
+        hash_megabytes = megabytes;
+    }
+
+    int hashSize() const { return hash_megabytes; }
+    void clearHash() { tt.clear(); }
+
+    enum class NodeType
+    {
+        ROOT,  // coups ordonnés par findBestMove (root_moves), meilleur coup dans root_best
+        PV,    // premier enfant de ROOT ou PV: sa valeur est celle du parent, pas de coupure par la table
+        NON_PV // les autres: coupures par les bornes de la table de transposition
+    };
+
+    template <int Root, int ToMove, NodeType Type>
+    double searchNode(const State &state, int current_depth, double alpha, double beta)
     {
         /**
-        Internal MinMax with Alpha-Beta Pruning and timeout checking
+        Min-Max avec élagage Alpha-Beta, spécialisé à la compilation:
+        - Root: joueur de la recherche (scores de son point de vue)
+        - ToMove: joueur au trait; nœud max si ToMove == Root, sinon min
+        - Type: racine (contrôle du temps avant chaque coup, sans table), PV ou non-PV
+        Aucun test sur le joueur au nœud: coups, semis, captures et évaluation sont instanciés par joueur
         */
-        nodes_explored++;
+        static_assert(Root == 1 || Root == 2, "joueur 1 ou 2");
+        static_assert(Type != NodeType::ROOT || ToMove == Root, "la racine est un nœud max");
+        constexpr bool maximizing = ToMove == Root;
+        constexpr bool is_root = Type == NodeType::ROOT;
+        constexpr NodeType first_child = Type == NodeType::NON_PV ? NodeType::NON_PV : NodeType::PV;
+        PROFILE_ZONE(PROFILE_SEARCH_NODE);
+
+        const int ply = root_depth - current_depth;
+        uint64_t key = 0;
+        Move tt_move;
+        if constexpr (!is_root)
+        {
+            nodes_explored++;
+            if (incremental)
+            {
+                // Accumulateur calculé seulement si une évaluation du sous-arbre le demande
+                accumulators[ply].state = &state;
+                accumulators[ply].ready = false;
+            }
+
+            // Check for timeout less frequently (every N nodes)
+            if (nodes_explored % CHECK_INTERVAL == 0)
+            {
+                auto now = std::chrono::steady_clock::now();
+                if (now - start_time > timeout_ms)
+                {
+                    timeout_reached = true;
+                    return 0;
+                }
+            }
+
+            // Terminal state
+            if (evaluator.isTerminal(state))
+            {
+                return Evaluator::terminalScore<Root>(state);
+            }
 
-        // Check for timeout less frequently (every N nodes)
-        if (nodes_explored % CHECK_INTERVAL == 0)
-        {
-            auto now = std::chrono::steady_clock::now();
-            if (now - start_time > timeout_ms)
+            // Depth reached
+            if (current_depth == 0)
             {
-                timeout_reached = true;
-                return 0;
+                return leafScore<Root>(state, ply);
             }
-        }
 
-        // Terminal state
-        if (evaluator.isTerminal(state))
-        {
-            return evaluator.getTerminalScore(state, original_player);
+            // Table de transposition: coupure (hors PV) si l'entrée suffit, sinon son coup est joué en premier
+            if (tt.enabled())
+            {
+                PROFILE_ZONE(PROFILE_HASH_PROBE);
+                key = TranspositionTable::key(state);
+                stats.tt_probes++;
+                if (const TTEntry *entry = tt.probe(key))
+                {
+                    stats.tt_hits++;
+                    tt_move = Move(entry->move);
+                    double value = entry->value;
+                    if (Type == NodeType::NON_PV && entry->depth >= current_depth &&
+                        (entry->bound == TranspositionTable::EXACT ||
+                         (entry->bound == TranspositionTable::LOWER && value >= beta) ||
+                         (entry->bound == TranspositionTable::UPPER && value <= alpha)))
+                    {
+                        return value;
+                    }
+                }
+            }
         }
 
-        // Depth reached
-        if (current_depth == 0)
+        MoveList moves = is_root ? root_moves : Generator::template generate<ToMove>(state);
+        if (moves.empty())
         {
-            return evaluator.evaluate(state, original_player);
+            return leafScore<Root>(state, ply);
         }
-
-        auto moves = MoveGenerator::getAllMoves(state, state.current_player);
-
-        if (moves.empty())
+        if (tt_move.valid())
         {
-            return evaluator.evaluate(state, original_player);
+            moveToFront(moves, tt_move);
         }
 
-        if (maximizing_player)
+        double alpha_start = alpha;
+        double beta_start = beta;
+        double best_eval = maximizing ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+        Move best_move;
+
+        for (const Move &move : moves)
         {
-            double max_eval = -std::numeric_limits<double>::infinity();
-            for (const auto &move : moves)
+            if constexpr (is_root)
             {
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
+                // Check for timeout before each move
+                auto now = std::chrono::steady_clock::now();
+                if (now - start_time > timeout_ms)
+                {
+                    timeout_reached = true;
+                    break;
+                }
+            }
 
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
-                double eval_score = _minmax(new_state, current_depth - 1, false, original_player, alpha, beta);
+            State new_state = Generator::template applyMove<ToMove>(state, move);
+            double eval_score = &move == moves.begin()
+                                    ? searchNode<Root, 3 - ToMove, first_child>(new_state, current_depth - 1, alpha, beta)
+                                    : searchNode<Root, 3 - ToMove, NodeType::NON_PV>(new_state, current_depth - 1, alpha, beta);
 
-                if (timeout_reached)
+            if (timeout_reached)
+            {
+                if constexpr (is_root)
                 {
-                    return 0;
+                    break;
                 }
+                return 0;
+            }
 
-                max_eval = std::max(max_eval, eval_score);
-                alpha = std::max(alpha, max_eval);
-                if (beta <= alpha)
+            if constexpr (maximizing)
+            {
+                if (eval_score > best_eval)
                 {
-                    break; // Beta cutoff
+                    best_eval = eval_score;
+                    best_move = move;
                 }
+                alpha = std::max(alpha, best_eval);
             }
-            return max_eval;
-        }
-        else
-        {
-            double min_eval = std::numeric_limits<double>::infinity();
-            for (const auto &move : moves)
+            else
             {
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
-
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
-                double eval_score = _minmax(new_state, current_depth - 1, true, original_player, alpha, beta);
-
-                if (timeout_reached)
+                if (eval_score < best_eval)
                 {
-                    return 0;
+                    best_eval = eval_score;
+                    best_move = move;
                 }
+                beta = std::min(beta, best_eval);
+            }
 
-                min_eval = std::min(min_eval, eval_score);
-                beta = std::min(beta, min_eval);
-                if (beta <= alpha)
-                {
-                    break; // Alpha cutoff
-                }
+            // La racine parcourt tous ses coups (fenêtre infinie)
+            if (!is_root && beta <= alpha)
+            {
+                stats.recordCutoff(&move == moves.begin());
+                break; // Beta (max) ou alpha (min) cutoff
             }
-            return min_eval;
         }
+
+        if constexpr (is_root)
+        {
+            root_best = best_move;
+        }
+        else if (tt.enabled())
+        {
+            TranspositionTable::Bound bound = best_eval >= beta_start    ? TranspositionTable::LOWER
+                                              : best_eval <= alpha_start ? TranspositionTable::UPPER
+                                                                         : TranspositionTable::EXACT;
+            tt.store(key, best_eval, current_depth, bound, best_move);
+        }
+        return best_eval;
     }
 
-    Move findBestMove(const GameState &state, int player, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000))
+    Move findBestMove(const State &state, int player, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000))
     {
         /**
         Find best move using iterative deepening with timeout
         Only saves results from fully completed depths
         */
-        auto moves = MoveGenerator::getAllMoves(state, player);
+        auto moves = Generator::getAllMoves(state, player);
 
         if (moves.empty())
         {
@@ -405,73 +1313,97 @@ public:
         // Start timing
         start_time = std::chrono::steady_clock::now();
         timeout_ms = timeout;
+        stats.clear();
+
+        // Scores de la table relatifs au joueur de la recherche: vidée si ce joueur change
+        if (tt.enabled())
+        {
+            if (player != tt_player)
+            {
+                tt.clear();
+                tt_player = player;
+            }
+            if (const TTEntry *entry = tt.probe(TranspositionTable::key(state)))
+            {
+                moveToFront(moves, Move(entry->move));
+            }
+        }
+
+        // Réseau: accumulateur de la racine, ceux des nœuds en sont déduits (leafScore)
+        incremental = false;
+        if constexpr (std::is_same<Rules, StandardRules>::value)
+        {
+            if (evaluator.network)
+            {
+                incremental = true;
+                accumulators.resize(max_depth + 1);
+                accumulators[0].state = &state;
+                accumulators[0].ready = true;
+                evaluator.network->refresh(state, accumulators[0].acc);
+            }
+        }
 
         // Best move from the last fully completed depth (default to first move)
-        auto first_move = moves[0];
-        Move best_move(std::get<0>(first_move), std::get<1>(first_move),
-                       std::get<2>(first_move), std::get<3>(first_move));
+        Move best_move = moves[0];
         double best_eval_completed = -std::numeric_limits<double>::infinity();
+        const double inf = std::numeric_limits<double>::infinity();
 
         // Iterative deepening: search from depth 1 to max_depth
         for (int current_depth = 1; current_depth <= max_depth; current_depth++)
         {
             timeout_reached = false;
             nodes_explored = 0;
-
-            Move best_move_this_depth;
-            double best_eval_this_depth = -std::numeric_limits<double>::infinity();
-            double alpha = -std::numeric_limits<double>::infinity();
-            double beta = std::numeric_limits<double>::infinity();
-
-            // Search all moves at current depth
-            for (const auto &move : moves)
-            {
-                // Check for timeout before each move
-                auto now = std::chrono::steady_clock::now();
-                if (now - start_time > timeout_ms)
-                {
-                    timeout_reached = true;
-                    break;
-                }
-
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
-
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
-                double eval_score = _minmax(new_state, current_depth - 1, false, player, alpha, beta);
-
-                if (timeout_reached)
-                {
-                    break;
-                }
-
-                if (eval_score > best_eval_this_depth)
-                {
-                    best_eval_this_depth = eval_score;
-                    best_move_this_depth = Move(hole, color, trans_as, use_trans);
-                }
-
-                alpha = std::max(alpha, best_eval_this_depth);
-            }
+            auto iteration_start = std::chrono::steady_clock::now();
+
+            // Racine: coups de moves dans leur ordre courant
+            root_moves = moves;
+            root_depth = current_depth;
+            double best_eval_this_depth = player == 1 ? searchNode<1, 1, NodeType::ROOT>(state, current_depth, -inf, inf)
+                                                      : searchNode<2, 2, NodeType::ROOT>(state, current_depth, -inf, inf);
+            Move best_move_this_depth = root_best;
+
+            bool completed = !timeout_reached && best_move_this_depth.valid();
+            long iteration_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                    std::chrono::steady_clock::now() - iteration_start)
+                                    .count();
+            stats.iterations.push_back({current_depth, nodes_explored, iteration_us, completed});
+            stats.nodes += nodes_explored;
 
             // Only update best move if this depth completed fully
-            if (!timeout_reached && best_move_this_depth.valid)
+            if (completed)
             {
                 best_move = best_move_this_depth;
                 best_eval_completed = best_eval_this_depth;
+                stats.depth_reached = current_depth;
+                stats.score = best_eval_completed;
+
+                // Coup retenu joué en premier à l'itération suivante
+                if (tt.enabled())
+                {
+                    tt.store(TranspositionTable::key(state), best_eval_completed, current_depth,
+                             TranspositionTable::EXACT, best_move);
+                    moveToFront(moves, best_move);
+                }
             }
             else
             {
                 break; // Timeout reached, use previous depth's result
             }
+
+            // Budget de nœuds épuisé: la profondeur suivante ne commence pas
+            if (node_limit > 0 && stats.nodes >= node_limit)
+            {
+                break;
+            }
         }
 
+        stats.time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start_time)
+                            .count();
         return best_move;
     }
 
-    std::pair<double, Move> search(const GameState &state, int player, int current_depth = 0,
+    std::pair<double, Move> search(const State &state, int player, int current_depth = 0,
                                    double alpha = -std::numeric_limits<double>::infinity(),
                                    double beta = std::numeric_limits<double>::infinity())
     {
@@ -498,22 +1430,17 @@ public:
             double max_eval = -std::numeric_limits<double>::infinity();
             Move best_move;
 
-            auto moves = MoveGenerator::getAllMoves(state, player);
+            auto moves = Generator::getAllMoves(state, player);
 
-            for (const auto &move : moves)
+            for (const Move &move : moves)
             {
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
-
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
+                State new_state = Generator::applyMove(state, move);
                 auto [eval_score, _] = search(new_state, player, current_depth + 1, alpha, beta);
 
                 if (eval_score > max_eval)
                 {
                     max_eval = eval_score;
-                    best_move = Move(hole, color, trans_as, use_trans);
+                    best_move = move;
                 }
 
                 alpha = std::max(alpha, eval_score);
@@ -532,22 +1459,17 @@ public:
             double min_eval = std::numeric_limits<double>::infinity();
             Move best_move;
 
-            auto moves = MoveGenerator::getAllMoves(state, opponent);
+            auto moves = Generator::getAllMoves(state, opponent);
 
-            for (const auto &move : moves)
+            for (const Move &move : moves)
             {
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
-
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
+                State new_state = Generator::applyMove(state, move);
                 auto [eval_score, _] = search(new_state, player, current_depth + 1, alpha, beta);
 
                 if (eval_score < min_eval)
                 {
                     min_eval = eval_score;
-                    best_move = Move(hole, color, trans_as, use_trans);
+                    best_move = move;
                 }
 
                 beta = std::min(beta, eval_score);
@@ -561,15 +1483,75 @@ public:
         }
     }
 
-    Move getMove(const GameState &state, int player)
+    Move getMove(const State &state, int player)
     {
         /**Interface publique pour obtenir un coup*/
         nodes_explored = 0;
         auto [_, move] = search(state, player, 0);
         return move;
     }
+
+private:
+    TranspositionTable tt;
+    int tt_player = 0; // joueur de la recherche dont les scores remplissent la table
+    int hash_megabytes = 0;
+    MoveList root_moves; // coups de la racine de l'itération en cours (NodeType::ROOT)
+    Move root_best;
+    int root_depth = 0;  // profondeur de l'itération en cours: ply = root_depth - current_depth
+
+    struct PathAccumulator
+    {
+        const State *state; // position du nœud courant à cette profondeur
+        NnueAccumulator acc;
+        bool ready;
+    };
+    std::vector<PathAccumulator> accumulators; // un par ply du chemin courant (réseau chargé)
+    bool incremental = false;
+
+    template <int Root>
+    double leafScore(const State &state, int ply)
+    {
+        /**
+        evaluate<Root>(); avec un réseau, l'accumulateur de la feuille est déduit de celui
+        de son parent (NnueNetwork::update) au lieu d'être recalculé
+        */
+        if constexpr (std::is_same<Rules, StandardRules>::value)
+        {
+            if (incremental)
+            {
+                int score = evaluator.network->output(pathAccumulator(ply));
+                return Root == 1 ? score : -score;
+            }
+        }
+        return evaluator.evaluate<Root>(state);
+    }
+
+    const NnueAccumulator &pathAccumulator(int ply)
+    {
+        /**Accumulateur du nœud courant à la profondeur ply, déduit à la demande de ses ancêtres*/
+        PathAccumulator &node = accumulators[ply];
+        if (!node.ready)
+        {
+            const NnueAccumulator &parent = pathAccumulator(ply - 1);
+            evaluator.network->update(*accumulators[ply - 1].state, *node.state, parent, node.acc);
+            node.ready = true;
+        }
+        return node.acc;
+    }
+
+    static void moveToFront(MoveList &moves, Move move)
+    {
+        /**Place move en tête, les autres coups gardent leur ordre*/
+        Move *found = std::find(moves.begin(), moves.end(), move);
+        if (found != moves.end())
+        {
+            std::rotate(moves.begin(), found, found + 1);
+        }
+    }
 };
 
+using MinMaxBot = BasicMinMaxBot<StandardRules>;
+
 class AlphaBetaBot
 {
 public:
@@ -617,14 +1599,9 @@ public:
 
             auto moves = MoveGenerator::getAllMoves(state, current_player);
 
-            for (const auto &move : moves)
+            for (const Move &move : moves)
             {
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
-
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
+                GameState new_state = MoveGenerator::applyMove(state, move);
 
                 // Déterminer si le prochain niveau est maximisant ou minimisant
                 bool next_is_maximizing = (new_state.current_player == player);
@@ -634,7 +1611,7 @@ public:
                 if (eval_score > max_eval)
                 {
                     max_eval = eval_score;
-                    best_move = Move(hole, color, trans_as, use_trans);
+                    best_move = move;
                 }
 
                 // Mise à jour d'alpha
@@ -658,14 +1635,9 @@ public:
 
             auto moves = MoveGenerator::getAllMoves(state, current_player);
 
-            for (const auto &move : moves)
+            for (const Move &move : moves)
             {
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
-
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
+                GameState new_state = MoveGenerator::applyMove(state, move);
 
                 // Déterminer si le prochain niveau est maximisant ou minimisant
                 bool next_is_maximizing = (new_state.current_player == player);
@@ -675,7 +1647,7 @@ public:
                 if (eval_score < min_eval)
                 {
                     min_eval = eval_score;
-                    best_move = Move(hole, color, trans_as, use_trans);
+                    best_move = move;
                 }
 
                 // Mise à jour de beta
@@ -747,20 +1719,33 @@ public:
             best_score = -std::numeric_limits<double>::infinity();
             auto moves = MoveGenerator::getAllMoves(state, player);
 
-            for (const auto &move : moves)
+            // Enfants à l'horizon: évalués en un seul lot
+            double leaf_scores[EvalBatch::CAPACITY];
+            bool horizon = current_depth + 1 >= depth_limit;
+            if (horizon)
             {
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
+                evaluator.evaluateChildren(state, moves, player, leaf_scores);
+                nodes_explored += static_cast<int>(moves.size());
+            }
 
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
-                auto [score, _] = dfsLimited(new_state, player, depth_limit, current_depth + 1);
+            for (size_t i = 0; i < moves.size(); i++)
+            {
+                Move move = moves[i];
+                double score;
+                if (horizon)
+                {
+                    score = leaf_scores[i];
+                }
+                else
+                {
+                    GameState new_state = MoveGenerator::applyMove(state, move);
+                    score = dfsLimited(new_state, player, depth_limit, current_depth + 1).first;
+                }
 
                 if (score > best_score)
                 {
                     best_score = score;
-                    best_move = Move(hole, color, trans_as, use_trans);
+                    best_move = move;
                 }
             }
         }
@@ -771,20 +1756,33 @@ public:
             best_score = std::numeric_limits<double>::infinity();
             auto moves = MoveGenerator::getAllMoves(state, opponent);
 
-            for (const auto &move : moves)
+            // Enfants à l'horizon: évalués en un seul lot
+            double leaf_scores[EvalBatch::CAPACITY];
+            bool horizon = current_depth + 1 >= depth_limit;
+            if (horizon)
             {
-                int hole = std::get<0>(move);
-                Color color = std::get<1>(move);
-                Color trans_as = std::get<2>(move);
-                bool use_trans = std::get<3>(move);
+                evaluator.evaluateChildren(state, moves, player, leaf_scores);
+                nodes_explored += static_cast<int>(moves.size());
+            }
 
-                GameState new_state = MoveGenerator::applyMove(state, hole, color, trans_as, use_trans);
-                auto [score, _] = dfsLimited(new_state, player, depth_limit, current_depth + 1);
+            for (size_t i = 0; i < moves.size(); i++)
+            {
+                Move move = moves[i];
+                double score;
+                if (horizon)
+                {
+                    score = leaf_scores[i];
+                }
+                else
+                {
+                    GameState new_state = MoveGenerator::applyMove(state, move);
+                    score = dfsLimited(new_state, player, depth_limit, current_depth + 1).first;
+                }
 
                 if (score < best_score)
                 {
                     best_score = score;
-                    best_move = Move(hole, color, trans_as, use_trans);
+                    best_move = move;
                 }
             }
         }
@@ -804,7 +1802,7 @@ public:
             nodes_explored = 0;
             auto [_, move] = dfsLimited(state, player, d);
 
-            if (move.valid)
+            if (move.valid())
             {
                 best_move = move;
                 // std::cout << "[ID-DFS] Profondeur " << d << ": " << nodes_explored << " nœuds explorés" << std::endl;
@@ -821,4 +1819,309 @@ public:
     }
 };
 
+// Nœud de l'arbre MCTS, stocké dans une arène contiguë (liens par index, pas de new par nœud)
+struct MCTSNode
+{
+    int parent;            // -1 pour la racine
+    int first_child;       // -1 tant que le nœud n'est pas développé
+    int num_children;      // les enfants occupent [first_child, first_child + num_children)
+    int player_just_moved; // joueur qui a joué `move` pour arriver dans ce nœud
+    Move move;
+    int visits;
+    int virtual_loss; // simulations en cours à travers ce nœud (autres threads)
+    double wins;      // du point de vue de player_just_moved (nulle = 0.5)
+    bool terminal;
+
+    MCTSNode() : parent(-1), first_child(-1), num_children(0), player_just_moved(0),
+                 visits(0), virtual_loss(0), wins(0.0), terminal(false) {}
+};
+
+class MCTSBot
+{
+public:
+    /**Monte Carlo Tree Search (UCT) avec arbre partagé entre threads et perte virtuelle*/
+    int num_threads;
+    int max_nodes;
+    double exploration;
+    std::chrono::milliseconds timeout_ms;
+    long long playouts; // simulations effectuées lors de la dernière recherche
+
+    MCTSBot(int time_ms = 2000, int threads = 0, int node_budget = 1000000)
+        : num_threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+          max_nodes(node_budget), exploration(1.4), timeout_ms(time_ms), playouts(0),
+          has_tree(false), seed(0x9E3779B97F4A7C15ULL)
+    {
+        nodes.reserve(max_nodes);
+    }
+
+    Move findBestMove(const GameState &state, int player, std::chrono::milliseconds timeout)
+    {
+        /**
+        Lance les simulations jusqu'à expiration du temps puis retourne le coup le plus visité
+        L'arbre de la recherche précédente est réutilisé s'il contient la position courante
+        */
+        GameState start = state.copy();
+        start.current_player = player;
+
+        if (start.isGameOver() || MoveGenerator::getAllMoves(start, player).empty())
+        {
+            return Move();
+        }
+
+        if (!reuseTree(start))
+        {
+            nodes.clear();
+            nodes.push_back(MCTSNode());
+            nodes[0].player_just_moved = 3 - player;
+        }
+        root_state = start;
+        has_tree = true;
+        playouts = 0;
+
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        // Parallélisme d'arbre: tous les threads partagent l'arène, la perte virtuelle les disperse
+        std::vector<std::thread> workers;
+        for (int t = 1; t < num_threads; t++)
+        {
+            workers.emplace_back(&MCTSBot::worker, this, deadline, nextSeed());
+        }
+        worker(deadline, nextSeed());
+        for (auto &w : workers)
+        {
+            w.join();
+        }
+
+        const MCTSNode &root = nodes[0];
+        int best = -1;
+        for (int i = 0; i < root.num_children; i++)
+        {
+            int c = root.first_child + i;
+            if (best == -1 || nodes[c].visits > nodes[best].visits)
+            {
+                best = c;
+            }
+        }
+
+        if (best == -1)
+        {
+            // Aucune expansion (temps nul): premier coup légal
+            return MoveGenerator::getAllMoves(start, player)[0];
+        }
+        return nodes[best].move;
+    }
+
+    Move getMove(const GameState &state, int player)
+    {
+        /**Interface publique pour obtenir un coup*/
+        return findBestMove(state, player, timeout_ms);
+    }
+
+private:
+    std::vector<MCTSNode> nodes; // arène: nodes[0] est la racine
+    GameState root_state;
+    bool has_tree;
+    uint64_t seed;
+    std::mutex tree_mutex;
+
+    uint64_t nextSeed()
+    {
+        seed += 0x9E3779B97F4A7C15ULL;
+        return seed;
+    }
+
+    int selectChild(int node) const
+    {
+        /**Sélection UCT; les simulations en cours comptent comme des visites perdues*/
+        const MCTSNode &p = nodes[node];
+        double log_n = std::log(static_cast<double>(p.visits + p.virtual_loss) + 1.0);
+        int best = p.first_child;
+        double best_value = -std::numeric_limits<double>::infinity();
+
+        for (int i = 0; i < p.num_children; i++)
+        {
+            int c = p.first_child + i;
+            const MCTSNode &child = nodes[c];
+            int n = child.visits + child.virtual_loss;
+            if (n == 0)
+            {
+                return c; // Enfant jamais exploré
+            }
+            double value = child.wins / n + exploration * std::sqrt(log_n / n);
+            if (value > best_value)
+            {
+                best_value = value;
+                best = c;
+            }
+        }
+        return best;
+    }
+
+    void expand(int node, const GameState &state)
+    {
+        /**Alloue les enfants d'un nœud en un bloc contigu de l'arène*/
+        auto moves = MoveGenerator::getAllMoves(state, state.current_player);
+        if (moves.empty())
+        {
+            nodes[node].terminal = true;
+            return;
+        }
+        if (nodes.size() + moves.size() > static_cast<size_t>(max_nodes))
+        {
+            return; // Arène pleine: le nœud reste une feuille
+        }
+
+        int first = static_cast<int>(nodes.size());
+        for (Move m : moves)
+        {
+            MCTSNode child;
+            child.parent = node;
+            child.player_just_moved = state.current_player;
+            child.move = m;
+            nodes.push_back(child);
+        }
+        nodes[node].first_child = first;
+        nodes[node].num_children = static_cast<int>(moves.size());
+    }
+
+    void worker(std::chrono::steady_clock::time_point deadline, uint64_t worker_seed)
+    {
+        XorShiftRng rng(worker_seed);
+        std::vector<int> path;
+
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            GameState state = root_state.copy();
+            GameEngine engine(&state);
+            path.clear();
+
+            {
+                std::lock_guard<std::mutex> lock(tree_mutex);
+
+                // Sélection
+                int node = 0;
+                path.push_back(node);
+                nodes[node].virtual_loss++;
+                while (nodes[node].first_child != -1)
+                {
+                    node = selectChild(node);
+                    engine.playMove(nodes[node].move);
+                    path.push_back(node);
+                    nodes[node].virtual_loss++;
+                }
+
+                // Expansion (la racine et les feuilles déjà visitées)
+                if (!nodes[node].terminal && state.isGameOver())
+                {
+                    nodes[node].terminal = true;
+                }
+                if (!nodes[node].terminal && (node == 0 || nodes[node].visits > 0))
+                {
+                    expand(node, state);
+                    if (nodes[node].first_child != -1)
+                    {
+                        node = nodes[node].first_child + static_cast<int>(rng.below(nodes[node].num_children));
+                        engine.playMove(nodes[node].move);
+                        path.push_back(node);
+                        nodes[node].virtual_loss++;
+                    }
+                }
+            }
+
+            // Simulation hors verrou: c'est là que les threads travaillent en parallèle
+            int winner = Playout::run(state, rng);
+
+            // Rétropropagation
+            std::lock_guard<std::mutex> lock(tree_mutex);
+            for (int n : path)
+            {
+                MCTSNode &node = nodes[n];
+                node.virtual_loss--;
+                node.visits++;
+                if (winner == 0)
+                {
+                    node.wins += 0.5;
+                }
+                else if (winner == node.player_just_moved)
+                {
+                    node.wins += 1.0;
+                }
+            }
+            playouts++;
+        }
+    }
+
+    bool reuseTree(const GameState &start)
+    {
+        /**
+        Cherche la position courante parmi les enfants (notre coup) et petits-enfants
+        (réponse adverse) de l'ancienne racine, puis compacte ce sous-arbre dans l'arène
+        */
+        if (!has_tree || nodes.empty())
+        {
+            return false;
+        }
+        if (root_state == start)
+        {
+            return true;
+        }
+
+        const MCTSNode &root = nodes[0];
+        for (int i = 0; i < root.num_children; i++)
+        {
+            int c = root.first_child + i;
+            GameState s1 = MoveGenerator::applyMove(root_state, nodes[c].move);
+            if (s1 == start)
+            {
+                rebase(c);
+                return true;
+            }
+            for (int j = 0; j < nodes[c].num_children; j++)
+            {
+                int gc = nodes[c].first_child + j;
+                GameState s2 = MoveGenerator::applyMove(s1, nodes[gc].move);
+                if (s2 == start)
+                {
+                    rebase(gc);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void rebase(int new_root)
+    {
+        /**Recopie le sous-arbre de new_root en tête d'une nouvelle arène (parcours en largeur)*/
+        std::vector<MCTSNode> compacted;
+        compacted.reserve(max_nodes);
+        compacted.push_back(nodes[new_root]);
+        compacted[0].parent = -1;
+        compacted[0].first_child = -1;
+
+        std::vector<std::pair<int, int>> queue; // (ancien index, nouvel index)
+        queue.push_back({new_root, 0});
+        for (size_t q = 0; q < queue.size(); q++)
+        {
+            auto [old_idx, new_idx] = queue[q];
+            const MCTSNode &old = nodes[old_idx];
+            if (old.first_child == -1)
+            {
+                continue;
+            }
+            int first = static_cast<int>(compacted.size());
+            compacted[new_idx].first_child = first;
+            for (int i = 0; i < old.num_children; i++)
+            {
+                MCTSNode child = nodes[old.first_child + i];
+                child.parent = new_idx;
+                child.first_child = -1;
+                compacted.push_back(child);
+                queue.push_back({old.first_child + i, first + i});
+            }
+        }
+        nodes.swap(compacted);
+    }
+};
+
 #endif // AI_ALGORITHMS_H
@@ -0,0 +1,511 @@
+/**
+ * Arbitre natif (Linux) - plusieurs parties en parallèle entre deux bots externes
+ * - Même protocole que Arbitre.java: "START" au joueur A, puis chaque coup est transmis à l'adversaire
+ * - Bots lancés avec posix_spawn, stdin/stdout reliés par des tubes
+ * - Une seule boucle epoll pilote toutes les parties en cours
+ * - Délai par coup mesuré avec CLOCK_MONOTONIC (dépassement = défaite)
+ * - Coups validés et joués par GameEngine (coup illégal = défaite)
+ * - Latence de chaque coup journalisée (CSV)
+ *
+ * Usage: arbitre --a ./botA --b ./botB [--games N] [--parallel P] [--timeout-ms 3000] [--log latences.csv]
+ * Les parties impaires inversent les camps (B joue JoueurA)
+ */
+
+#include "game_rules.h"
+#include "game_engine.h"
+#include "move.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/epoll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+// Fin de partie normale: délai laissé aux bots pour finir seuls (stdin fermé) avant SIGKILL
+static constexpr int EXIT_GRACE_MS = 200;
+
+static int64_t monotonicMicros()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+struct BotProcess
+{
+    pid_t pid = -1;
+    int to_bot = -1;   // stdin du bot
+    int from_bot = -1; // stdout du bot (non bloquant, surveillé par epoll)
+    std::string buffer;
+
+    bool spawn(const std::string &path, const char *role)
+    {
+        /**Lance le bot avec ses tubes (O_CLOEXEC: les autres bots n'en héritent pas)*/
+        int in_pipe[2], out_pipe[2];
+        if (pipe2(in_pipe, O_CLOEXEC) != 0)
+        {
+            return false;
+        }
+        if (pipe2(out_pipe, O_CLOEXEC) != 0)
+        {
+            close(in_pipe[0]);
+            close(in_pipe[1]);
+            return false;
+        }
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, in_pipe[0], STDIN_FILENO);
+        posix_spawn_file_actions_adddup2(&actions, out_pipe[1], STDOUT_FILENO);
+
+        char *argv[] = {const_cast<char *>(path.c_str()), const_cast<char *>(role), nullptr};
+        int rc = posix_spawn(&pid, path.c_str(), &actions, nullptr, argv, environ);
+        posix_spawn_file_actions_destroy(&actions);
+
+        close(in_pipe[0]);
+        close(out_pipe[1]);
+        to_bot = in_pipe[1];
+        from_bot = out_pipe[0];
+        fcntl(from_bot, F_SETFL, fcntl(from_bot, F_GETFL) | O_NONBLOCK);
+
+        if (rc != 0)
+        {
+            pid = -1;
+            return false;
+        }
+        return true;
+    }
+
+    bool send(const std::string &line)
+    {
+        std::string message = line + "\n";
+        return write(to_bot, message.data(), message.size()) == static_cast<ssize_t>(message.size());
+    }
+
+    void closeInput()
+    {
+        /**Fin de fichier sur le stdin du bot*/
+        if (to_bot >= 0)
+        {
+            close(to_bot);
+            to_bot = -1;
+        }
+    }
+
+    void terminate(int64_t grace_until = 0)
+    {
+        /**Ferme les tubes et arrête le bot; jusqu'à grace_until (monotonicMicros) il peut quitter seul*/
+        closeInput();
+        while (pid > 0 && monotonicMicros() < grace_until)
+        {
+            if (waitpid(pid, nullptr, WNOHANG) == pid)
+            {
+                pid = -1;
+                break;
+            }
+            usleep(1000);
+        }
+        if (from_bot >= 0)
+        {
+            close(from_bot);
+            from_bot = -1;
+        }
+        if (pid > 0)
+        {
+            kill(pid, SIGKILL);
+            waitpid(pid, nullptr, 0);
+            pid = -1;
+        }
+    }
+};
+
+enum class GameEnd
+{
+    NONE,
+    NORMAL,  // fin selon les règles (ou RESULT/NOMOVE du bot)
+    TIMEOUT, // délai dépassé
+    ILLEGAL, // coup illégal ou illisible
+    CRASH    // le bot a fermé sa sortie
+};
+
+struct ArbiterGame
+{
+    int id;
+    int engine_of_player[3]; // engine_of_player[1] = bot (0 = A, 1 = B) qui joue JoueurA
+    BotProcess bots[3];      // indexés par joueur (1, 2)
+    GameState state;
+    GameEngine engine;
+    int to_move = 1;
+    int64_t sent_at = 0;
+    GameEnd end = GameEnd::NONE;
+    int loser = 0; // joueur fautif (TIMEOUT, ILLEGAL, CRASH)
+    std::string detail;
+
+    ArbiterGame() : engine(&state) {}
+};
+
+struct LatencyRecord
+{
+    int game;
+    int ply;
+    int engine;
+    int64_t micros;
+    std::string move;
+};
+
+class Arbiter
+{
+public:
+    std::string paths[2];
+    int timeout_ms = 3000;
+    std::vector<LatencyRecord> latencies;
+    int score[2][3] = {}; // [bot][0 = défaites, 1 = nulles, 2 = victoires]
+    int faults[2] = {};
+
+    Arbiter() : epoll_fd(epoll_create1(EPOLL_CLOEXEC)) {}
+    ~Arbiter() { close(epoll_fd); }
+
+    void run(int total_games, int parallel)
+    {
+        /**Garde `parallel` parties en cours jusqu'à en avoir joué `total_games`*/
+        int started = 0;
+        int running = 0;
+        std::vector<std::unique_ptr<ArbiterGame>> games(total_games);
+
+        auto start_next = [&]()
+        {
+            while (running < parallel && started < total_games)
+            {
+                games[started] = startGame(started);
+                started++;
+                running++;
+            }
+        };
+        start_next();
+
+        epoll_event events[64];
+        while (running > 0)
+        {
+            int wait_ms = nextDeadlineMs(games);
+            int count = epoll_wait(epoll_fd, events, 64, wait_ms);
+            if (count < 0 && errno != EINTR)
+            {
+                perror("epoll_wait");
+                break;
+            }
+
+            for (int e = 0; e < count; e++)
+            {
+                ArbiterGame *game = games[events[e].data.u32 >> 2].get();
+                int player = events[e].data.u32 & 3;
+                if (game && game->end == GameEnd::NONE)
+                {
+                    onReadable(*game, player);
+                }
+            }
+
+            int64_t now = monotonicMicros();
+            for (auto &game : games)
+            {
+                if (game && game->end == GameEnd::NONE && now - game->sent_at > timeout_ms * 1000LL)
+                {
+                    finish(*game, GameEnd::TIMEOUT, game->to_move, "délai dépassé");
+                }
+            }
+
+            for (auto &game : games)
+            {
+                if (game && game->end != GameEnd::NONE)
+                {
+                    report(*game);
+                    game.reset();
+                    running--;
+                }
+            }
+            start_next();
+        }
+    }
+
+private:
+    int epoll_fd;
+
+    std::unique_ptr<ArbiterGame> startGame(int id)
+    {
+        auto game = std::make_unique<ArbiterGame>();
+        game->id = id;
+        // Parties impaires: camps inversés
+        game->engine_of_player[1] = (id % 2 == 0) ? 0 : 1;
+        game->engine_of_player[2] = 1 - game->engine_of_player[1];
+
+        for (int player = 1; player <= 2; player++)
+        {
+            BotProcess &bot = game->bots[player];
+            if (!bot.spawn(paths[game->engine_of_player[player]], player == 1 ? "JoueurA" : "JoueurB"))
+            {
+                finish(*game, GameEnd::CRASH, player, "lancement impossible");
+                return game;
+            }
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.u32 = static_cast<uint32_t>(id) << 2 | static_cast<uint32_t>(player);
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, bot.from_bot, &ev);
+        }
+
+        sendTo(*game, 1, "START");
+        return game;
+    }
+
+    void sendTo(ArbiterGame &game, int player, const std::string &line)
+    {
+        game.to_move = player;
+        game.sent_at = monotonicMicros();
+        if (!game.bots[player].send(line))
+        {
+            finish(game, GameEnd::CRASH, player, "écriture impossible");
+        }
+    }
+
+    int nextDeadlineMs(const std::vector<std::unique_ptr<ArbiterGame>> &games) const
+    {
+        /**
+        Attente maximale avant la prochaine échéance; 0 si une partie est déjà finie
+        (lancement ou écriture impossible dans startGame): plus aucun descripteur ne la réveillerait
+        */
+        int64_t now = monotonicMicros();
+        int64_t earliest = -1;
+        for (const auto &game : games)
+        {
+            if (game && game->end != GameEnd::NONE)
+            {
+                return 0;
+            }
+            if (game)
+            {
+                int64_t remaining = game->sent_at + timeout_ms * 1000LL - now;
+                earliest = (earliest < 0) ? remaining : std::min(earliest, remaining);
+            }
+        }
+        return earliest < 0 ? -1 : static_cast<int>(std::max<int64_t>(0, earliest / 1000 + 1));
+    }
+
+    void onReadable(ArbiterGame &game, int player)
+    {
+        BotProcess &bot = game.bots[player];
+        char chunk[4096];
+        bool closed = false;
+        while (true)
+        {
+            ssize_t n = read(bot.from_bot, chunk, sizeof(chunk));
+            if (n > 0)
+            {
+                bot.buffer.append(chunk, static_cast<size_t>(n));
+                continue;
+            }
+            closed = (n == 0);
+            break; // EAGAIN: tout est lu
+        }
+
+        size_t newline;
+        while (game.end == GameEnd::NONE && (newline = bot.buffer.find('\n')) != std::string::npos)
+        {
+            std::string line = bot.buffer.substr(0, newline);
+            bot.buffer.erase(0, newline + 1);
+            line.erase(0, line.find_first_not_of(" \t\r"));
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            if (!line.empty())
+            {
+                onLine(game, player, line);
+            }
+        }
+
+        // Un bot qui écrit son dernier coup puis quitte n'est pas en faute: ses lignes passent d'abord
+        if (closed && game.end == GameEnd::NONE)
+        {
+            finish(game, GameEnd::CRASH, player, "sortie fermée");
+        }
+    }
+
+    void onLine(ArbiterGame &game, int player, const std::string &line)
+    {
+        if (player != game.to_move)
+        {
+            finish(game, GameEnd::ILLEGAL, player, "a parlé hors de son tour: " + line);
+            return;
+        }
+
+        int64_t latency = monotonicMicros() - game.sent_at;
+        latencies.push_back({game.id, game.state.move_count + 1, game.engine_of_player[player], latency, line});
+
+        if (latency > timeout_ms * 1000LL)
+        {
+            finish(game, GameEnd::TIMEOUT, player, "délai dépassé");
+            return;
+        }
+        if (line.rfind("RESULT", 0) == 0 || line == "NOMOVE" || line == "PASS")
+        {
+            finish(game, GameEnd::NORMAL, 0, line);
+            return;
+        }
+
+        if (!game.engine.playMove(Move::parse(line.data(), line.size())))
+        {
+            finish(game, GameEnd::ILLEGAL, player, "coup invalide: " + line);
+            return;
+        }
+
+        if (game.state.isGameOver())
+        {
+            // Le dernier coup est transmis: l'adversaire voit la fin de partie et peut la journaliser
+            game.bots[3 - player].send(line);
+            finish(game, GameEnd::NORMAL, 0, "fin de partie");
+            return;
+        }
+        sendTo(game, 3 - player, line);
+    }
+
+    void finish(ArbiterGame &game, GameEnd end, int loser, const std::string &detail)
+    {
+        game.end = end;
+        game.loser = loser;
+        game.detail = detail;
+        // Fin normale: stdin fermé pour les deux bots, puis un court délai pour qu'ils quittent seuls
+        // (journal de partie); en cas de faute, arrêt immédiat
+        int64_t grace_until = end == GameEnd::NORMAL ? monotonicMicros() + EXIT_GRACE_MS * 1000LL : 0;
+        for (int player = 1; player <= 2; player++)
+        {
+            if (game.bots[player].from_bot >= 0)
+            {
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, game.bots[player].from_bot, nullptr);
+            }
+            game.bots[player].closeInput();
+        }
+        for (int player = 1; player <= 2; player++)
+        {
+            game.bots[player].terminate(grace_until);
+        }
+    }
+
+    void report(const ArbiterGame &game)
+    {
+        int winner = (game.end == GameEnd::NORMAL) ? game.state.getWinner() : 3 - game.loser;
+        if (game.end != GameEnd::NORMAL)
+        {
+            faults[game.engine_of_player[game.loser]]++;
+        }
+        for (int player = 1; player <= 2; player++)
+        {
+            int engine = game.engine_of_player[player];
+            score[engine][winner == 0 ? 1 : (winner == player ? 2 : 0)]++;
+        }
+
+        const char *names = "AB";
+        std::printf("partie %d: %c(J1) vs %c(J2) - %d coups, %d-%d, %s (%s)\n", game.id + 1,
+                    names[game.engine_of_player[1]], names[game.engine_of_player[2]], game.state.move_count,
+                    game.state.captured_seeds[1], game.state.captured_seeds[2],
+                    winner == 0 ? "nulle" : (winner == 1 ? "J1 gagne" : "J2 gagne"), game.detail.c_str());
+        std::fflush(stdout);
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    Arbiter arbiter;
+    int games = 2;
+    int parallel = 8;
+    std::string log_path;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--a" && has_value)
+        {
+            arbiter.paths[0] = argv[++i];
+        }
+        else if (arg == "--b" && has_value)
+        {
+            arbiter.paths[1] = argv[++i];
+        }
+        else if (arg == "--games" && has_value)
+        {
+            games = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--parallel" && has_value)
+        {
+            parallel = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--timeout-ms" && has_value)
+        {
+            arbiter.timeout_ms = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--log" && has_value)
+        {
+            log_path = argv[++i];
+        }
+        else
+        {
+            arbiter.paths[0].clear();
+            break;
+        }
+    }
+    if (arbiter.paths[0].empty() || arbiter.paths[1].empty())
+    {
+        std::cerr << "Usage: arbitre --a ./botA --b ./botB [--games N] [--parallel P] [--timeout-ms 3000] [--log latences.csv]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::signal(SIGPIPE, SIG_IGN); // un bot mort ne doit pas tuer l'arbitre
+
+    arbiter.run(games, parallel);
+
+    std::printf("\nA: %s\n  %d victoires, %d nulles, %d défaites, %d fautes\n", arbiter.paths[0].c_str(),
+                arbiter.score[0][2], arbiter.score[0][1], arbiter.score[0][0], arbiter.faults[0]);
+    std::printf("B: %s\n  %d victoires, %d nulles, %d défaites, %d fautes\n", arbiter.paths[1].c_str(),
+                arbiter.score[1][2], arbiter.score[1][1], arbiter.score[1][0], arbiter.faults[1]);
+
+    // Latences par bot: médiane, p99, max
+    for (int engine = 0; engine < 2; engine++)
+    {
+        std::vector<int64_t> values;
+        for (const LatencyRecord &r : arbiter.latencies)
+        {
+            if (r.engine == engine)
+            {
+                values.push_back(r.micros);
+            }
+        }
+        if (values.empty())
+        {
+            continue;
+        }
+        std::sort(values.begin(), values.end());
+        std::printf("latence %c: %zu coups, médiane %.1f ms, p99 %.1f ms, max %.1f ms\n", "AB"[engine], values.size(),
+                    values[values.size() / 2] / 1000.0, values[(values.size() - 1) * 99 / 100] / 1000.0,
+                    values.back() / 1000.0);
+    }
+
+    if (!log_path.empty())
+    {
+        std::ofstream log(log_path);
+        log << "partie,coup,bot,latence_us,coup_joue\n";
+        for (const LatencyRecord &r : arbiter.latencies)
+        {
+            log << r.game + 1 << "," << r.ply << "," << "AB"[r.engine] << "," << r.micros << "," << r.move << "\n";
+        }
+    }
+    return 0;
+}
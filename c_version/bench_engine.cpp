@@ -0,0 +1,463 @@
+/**
+ * Micro-benchmarks des primitives du moteur
+ * - Corpus de positions fixe (graine déterministe), tiré de parties aléatoires
+ * - Échauffement, puis de nombreuses répétitions par primitive
+ * - Médiane et percentiles en ns par opération, export JSON pour comparer deux runs
+ *
+ * Usage: bench_engine [--json fichier] [--reps N] [--corpus N] [--seed S]
+ */
+
+#include "game_rules.h"
+#include "game_engine.h"
+#include "ai_algorithms.h"
+#include "move.h"
+#include "playout.h"
+#include "nnue.h"
+#include "notation.h"
+#include "protocol.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <cstdio>
+#include <fcntl.h>
+
+struct BenchResult
+{
+    std::string name;
+    size_t ops_per_sample;
+    std::vector<double> ns_per_op; // un échantillon par répétition, trié
+};
+
+static volatile uint64_t bench_sink = 0; // empêche l'élimination du code mesuré
+
+static double percentile(const std::vector<double> &sorted, double p)
+{
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+static BenchResult runBench(const std::string &name, size_t ops, int warmup, int reps,
+                            const std::function<uint64_t()> &sample)
+{
+    /**Exécute `sample` (qui traite `ops` opérations) warmup + reps fois*/
+    BenchResult result{name, ops, {}};
+    for (int i = 0; i < warmup; i++)
+    {
+        bench_sink = bench_sink + sample();
+    }
+    for (int i = 0; i < reps; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t check = sample();
+        auto end = std::chrono::steady_clock::now();
+        bench_sink = bench_sink + check;
+        result.ns_per_op.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+    }
+    std::sort(result.ns_per_op.begin(), result.ns_per_op.end());
+    return result;
+}
+
+static std::vector<GameState> buildCorpus(size_t count, uint64_t seed)
+{
+    /**Positions tirées uniformément dans des parties aléatoires (graine fixe)*/
+    XorShiftRng rng(seed);
+    std::vector<GameState> corpus;
+    corpus.reserve(count);
+    while (corpus.size() < count)
+    {
+        GameState state;
+        int stop = static_cast<int>(rng.below(120));
+        while (!state.isGameOver() && state.move_count < stop)
+        {
+            uint32_t mask = Playout::legalMoveMask(state, state.current_player);
+            if (mask == 0)
+            {
+                break;
+            }
+            Playout::applyFast(state, Playout::randomMove(mask, rng));
+        }
+        if (!state.isGameOver() && Playout::legalMoveMask(state, state.current_player) != 0)
+        {
+            corpus.push_back(state);
+        }
+    }
+    return corpus;
+}
+
+static void writeJson(std::ostream &out, const std::vector<BenchResult> &results, uint64_t seed,
+                      size_t corpus_size, int warmup, int reps)
+{
+    out << "{\n  \"benchmark\": \"bench_engine\",\n"
+        << "  \"seed\": " << seed << ",\n"
+        << "  \"corpus\": " << corpus_size << ",\n"
+        << "  \"warmup\": " << warmup << ",\n"
+        << "  \"reps\": " << reps << ",\n"
+        << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"ops_per_sample\": %zu, \"ns_per_op\": "
+                      "{\"min\": %.3f, \"median\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f}}",
+                      r.name.c_str(), r.ops_per_sample, r.ns_per_op.front(), percentile(r.ns_per_op, 0.5),
+                      percentile(r.ns_per_op, 0.9), percentile(r.ns_per_op, 0.99), r.ns_per_op.back());
+        out << line << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char *argv[])
+{
+    std::string json_path;
+    int reps = 51;
+    int warmup = 5;
+    size_t corpus_size = 4096;
+    uint64_t seed = 20250101;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc)
+        {
+            json_path = argv[++i];
+        }
+        else if (arg == "--reps" && i + 1 < argc)
+        {
+            reps = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--corpus" && i + 1 < argc)
+        {
+            corpus_size = static_cast<size_t>(std::max(1, std::stoi(argv[++i])));
+        }
+        else if (arg == "--seed" && i + 1 < argc)
+        {
+            seed = std::stoull(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "Usage: bench_engine [--json fichier] [--reps N] [--corpus N] [--seed S]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<GameState> corpus = buildCorpus(corpus_size, seed);
+    std::vector<BenchResult> results;
+
+    // GameState::copy
+    results.push_back(runBench("GameState::copy", corpus.size(), warmup, reps, [&]()
+    {
+        uint64_t check = 0;
+        for (const GameState &s : corpus)
+        {
+            GameState c = s.copy();
+            check += c.holes.seeds[0][check & 15];
+        }
+        return check;
+    }));
+
+    // GameEngine::playMove par type de coup (copie de l'état comprise)
+    const char *type_names[4] = {"R", "B", "TR", "TB"};
+    for (int type = 0; type < 4; type++)
+    {
+        struct Case
+        {
+            const GameState *state;
+            Move move;
+        };
+        std::vector<Case> cases;
+        for (const GameState &s : corpus)
+        {
+            uint32_t mask = Playout::legalMoveMask(s, s.current_player);
+            for (int i = 0; i < 8; i++)
+            {
+                if (mask & (1u << (4 * i + type)))
+                {
+                    cases.push_back({&s, Playout::toMove(4 * i + type, s.current_player)});
+                    break;
+                }
+            }
+        }
+
+        results.push_back(runBench(std::string("GameEngine::playMove ") + type_names[type], cases.size(), warmup, reps, [&]()
+        {
+            uint64_t check = 0;
+            for (const Case &c : cases)
+            {
+                GameState s = *c.state;
+                GameEngine engine(&s);
+                check += engine.playMove(c.move) + s.captured_seeds[1];
+            }
+            return check;
+        }));
+
+        // Même coup par le noyau de recherche (joueur fixé à la compilation, sans validation)
+        results.push_back(runBench(std::string("GameEngine::makeMove ") + type_names[type], cases.size(), warmup, reps, [&]()
+        {
+            uint64_t check = 0;
+            for (const Case &c : cases)
+            {
+                GameState s = *c.state;
+                if (s.current_player == 1)
+                {
+                    GameEngine::makeMove<1>(s, c.move);
+                }
+                else
+                {
+                    GameEngine::makeMove<2>(s, c.move);
+                }
+                check += s.captured_seeds[1];
+            }
+            return check;
+        }));
+    }
+
+    // Capture (GameEngine::capture, appelée par captureSeeds) sur des plateaux juste semés
+    {
+        struct Case
+        {
+            GameState sown;
+            int last;
+        };
+        std::vector<Case> cases;
+        XorShiftRng rng(seed ^ 0xCAFE);
+        for (const GameState &s : corpus)
+        {
+            uint32_t mask = Playout::legalMoveMask(s, s.current_player);
+            int bit = Playout::randomMove(mask, rng);
+            Case c{s, 0};
+            c.last = GameEngine::sow(c.sown.holes.seeds, Playout::holeOf(bit, s.current_player) - 1, bit & 1, (bit & 3) >= 2);
+            cases.push_back(c);
+        }
+        results.push_back(runBench("GameEngine::captureSeeds", cases.size(), warmup, reps, [&]()
+        {
+            uint64_t check = 0;
+            for (const Case &c : cases)
+            {
+                HoleTable board = c.sown.holes;
+                check += GameEngine::capture(board.seeds, c.last);
+            }
+            return check;
+        }));
+    }
+
+    // MoveGenerator::getAllMoves
+    results.push_back(runBench("MoveGenerator::getAllMoves", corpus.size(), warmup, reps, [&]()
+    {
+        uint64_t check = 0;
+        for (const GameState &s : corpus)
+        {
+            check += MoveGenerator::getAllMoves(s, s.current_player).size();
+        }
+        return check;
+    }));
+
+    // Evaluator::evaluateWeights
+    results.push_back(runBench("Evaluator::evaluateWeights", corpus.size(), warmup, reps, [&]()
+    {
+        double check = 0;
+        for (const GameState &s : corpus)
+        {
+            check += Evaluator::evaluateWeights(s, s.current_player);
+        }
+        return static_cast<uint64_t>(check);
+    }));
+
+    // NnueNetwork (poids aléatoires: seul le coût compte): accumulateur complet, puis
+    // déduit de celui du parent comme dans Evaluator::evaluateChildren
+    {
+        std::unique_ptr<NnueNetwork> network(new NnueNetwork());
+        XorShiftRng weights_rng(seed);
+        for (int i = 0; i < NnueNetwork::INPUTS; i++)
+        {
+            for (int j = 0; j < NnueNetwork::HIDDEN; j++)
+            {
+                network->w1[i][j] = static_cast<int16_t>(static_cast<int>(weights_rng.below(64)) - 32);
+            }
+        }
+        for (int j = 0; j < NnueNetwork::HIDDEN; j++)
+        {
+            network->w2[j] = static_cast<int16_t>(static_cast<int>(weights_rng.below(128)) - 64);
+        }
+
+        std::vector<GameState> children;
+        std::vector<NnueAccumulator> parents(corpus.size());
+        for (size_t i = 0; i < corpus.size(); i++)
+        {
+            MoveList moves = MoveGenerator::getAllMoves(corpus[i], corpus[i].current_player);
+            children.push_back(moves.empty() ? corpus[i] : MoveGenerator::applyMove(corpus[i], moves[i % moves.size()]));
+            network->refresh(corpus[i], parents[i]);
+        }
+
+        results.push_back(runBench("NnueNetwork::evaluate", corpus.size(), warmup, reps, [&]()
+        {
+            int64_t check = 0;
+            for (const GameState &s : corpus)
+            {
+                check += network->evaluate(s, s.current_player);
+            }
+            return static_cast<uint64_t>(check);
+        }));
+
+        results.push_back(runBench("NnueNetwork::update+output", corpus.size(), warmup, reps, [&]()
+        {
+            int64_t check = 0;
+            NnueAccumulator acc;
+            for (size_t i = 0; i < corpus.size(); i++)
+            {
+                network->update(corpus[i], children[i], parents[i], acc);
+                check += network->output(acc);
+            }
+            return static_cast<uint64_t>(check);
+        }));
+    }
+
+    // GameState::isGameOver
+    results.push_back(runBench("GameState::isGameOver", corpus.size(), warmup, reps, [&]()
+    {
+        uint64_t check = 0;
+        for (const GameState &s : corpus)
+        {
+            check += s.isGameOver();
+        }
+        return check;
+    }));
+
+    // Notation: texte et binaire, dans les deux sens
+    {
+        std::vector<char> texts(corpus.size() * Notation::MAX_TEXT_LENGTH);
+        std::vector<size_t> lengths(corpus.size());
+        std::vector<PackedPosition> packed(corpus.size());
+        for (size_t i = 0; i < corpus.size(); i++)
+        {
+            lengths[i] = Notation::write(corpus[i], &texts[i * Notation::MAX_TEXT_LENGTH], Notation::MAX_TEXT_LENGTH);
+            Notation::pack(corpus[i], packed[i]);
+        }
+
+        results.push_back(runBench("Notation::write", corpus.size(), warmup, reps, [&]()
+        {
+            uint64_t check = 0;
+            char buffer[Notation::MAX_TEXT_LENGTH];
+            for (const GameState &s : corpus)
+            {
+                check += Notation::write(s, buffer, sizeof(buffer));
+            }
+            return check;
+        }));
+
+        results.push_back(runBench("Notation::parse", corpus.size(), warmup, reps, [&]()
+        {
+            uint64_t check = 0;
+            GameState s;
+            for (size_t i = 0; i < corpus.size(); i++)
+            {
+                check += Notation::parse(&texts[i * Notation::MAX_TEXT_LENGTH], lengths[i], s) + s.move_count;
+            }
+            return check;
+        }));
+
+        results.push_back(runBench("Notation::pack", corpus.size(), warmup, reps, [&]()
+        {
+            uint64_t check = 0;
+            PackedPosition p{};
+            for (const GameState &s : corpus)
+            {
+                check += Notation::pack(s, p) + p.bytes[check & 31];
+            }
+            return check;
+        }));
+
+        results.push_back(runBench("Notation::unpack", corpus.size(), warmup, reps, [&]()
+        {
+            uint64_t check = 0;
+            GameState s;
+            for (const PackedPosition &p : packed)
+            {
+                check += Notation::unpack(p, s) + s.move_count;
+            }
+            return check;
+        }));
+    }
+
+    // Coups: texte du protocole <-> code d'un octet (coups légaux du corpus)
+    {
+        std::vector<Move> moves;
+        for (const GameState &s : corpus)
+        {
+            for (Move m : MoveGenerator::getAllMoves(s, s.current_player))
+            {
+                moves.push_back(m);
+            }
+        }
+
+        results.push_back(runBench("Move::text", moves.size(), warmup, reps, [&]()
+        {
+            uint64_t check = 0;
+            for (Move m : moves)
+            {
+                check += m.textLength() + static_cast<uint8_t>(m.text()[0]);
+            }
+            return check;
+        }));
+
+        results.push_back(runBench("Move::parse", moves.size(), warmup, reps, [&]()
+        {
+            uint64_t check = 0;
+            for (Move m : moves)
+            {
+                check += Move::parse(m.text(), m.textLength()).code;
+            }
+            return check;
+        }));
+    }
+
+    // Réponse au protocole: formatage et write() vers /dev/null (coût d'un appel système)
+    {
+        int null_fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+        if (null_fd >= 0)
+        {
+            std::vector<Move> replies;
+            for (const GameState &s : corpus)
+            {
+                replies.push_back(MoveGenerator::getAllMoves(s, s.current_player).front());
+            }
+            ProtocolWriter writer(null_fd);
+            results.push_back(runBench("ProtocolWriter move+flush", replies.size(), warmup, reps, [&]()
+            {
+                uint64_t check = 0;
+                for (Move m : replies)
+                {
+                    writer.move(m);
+                    check += writer.flush();
+                }
+                return check;
+            }));
+            close(null_fd);
+        }
+    }
+
+    std::printf("%-30s %10s %10s %10s %10s\n", "primitive", "min", "median", "p90", "p99");
+    for (const BenchResult &r : results)
+    {
+        std::printf("%-30s %10.2f %10.2f %10.2f %10.2f  ns/op\n", r.name.c_str(), r.ns_per_op.front(),
+                    percentile(r.ns_per_op, 0.5), percentile(r.ns_per_op, 0.9), percentile(r.ns_per_op, 0.99));
+    }
+
+    if (!json_path.empty())
+    {
+        std::ofstream out(json_path);
+        if (!out)
+        {
+            std::cerr << "Impossible d'écrire " << json_path << std::endl;
+            return 1;
+        }
+        writeJson(out, results, seed, corpus.size(), warmup, reps);
+    }
+
+    return 0;
+}
@@ -1,149 +1,384 @@
 #include "game_rules.h"
 #include "game_engine.h"
 #include "ai_algorithms.h"
+#include "move.h"
+#include "playout.h"
+#include "config.h"
+#include "profiler.h"
+#include "thread_pool.h"
+#include "notation.h"
+#include "game_log.h"
+#include "protocol.h"
+#include "nnue.h"
+#include "engine_options.h"
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <sstream>
-#include <tuple>
-#include <optional>
 #include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 
-struct ParsedMove
-{
-    int hole;
-    Color color;
-    std::optional<Color> trans_as;
-    bool valid;
-};
+// Réseau d'évaluation (option nnue), partagé en lecture par toutes les recherches
+static const NnueNetwork *eval_network = nullptr;
+
+// Entraînement de profil (PGO / BOLT): profondeur fixe pour un travail déterministe
+const int SELFPLAY_DEPTH = 6;
+const int SELFPLAY_OPENING_PLIES = 4;
 
-ParsedMove parse_move(const std::string &move_str)
+int run_selfplay_train(int games, const EngineOptions &options)
 {
-    ParsedMove result = {0, Color::RED, std::nullopt, false};
+    /**
+    Auto-jeu sans interface: `games` parties MinMax contre MinMax
+    Passe par les vrais chemins MinMaxBot::findBestMove et GameEngine::playMove
+    (table de transposition comprise, à la taille de l'option hash)
+    Ouvertures tirées avec une graine fixe (par partie) pour varier les positions
+    La profondeur est bornée et le délai large: le profil ne dépend pas de la machine
+    */
+    MinMaxBot bot(1);
+    bot.max_depth = SELFPLAY_DEPTH;
+    bot.setHashSize(options.hash_mb);
+    bot.evaluator.network = eval_network;
+
+    long total_moves = 0;
+    int wins[3] = {0, 0, 0};
+    auto start_time = std::chrono::steady_clock::now();
 
-    try
+    for (int game = 0; game < games; game++)
     {
-        std::string upper_move = move_str;
-        for (auto &c : upper_move)
-            c = std::toupper(c);
+        GameState state;
+        GameEngine engine(&state);
+        XorShiftRng rng(0x5E1F + game);
 
-        if (upper_move.length() >= 3 && upper_move[upper_move.length() - 2] == 'T')
+        while (!state.isGameOver())
         {
-            result.hole = std::stoi(upper_move.substr(0, upper_move.length() - 2));
-            result.color = Color::TRANSPARENT;
+            int player = state.current_player;
+            Move move;
 
-            char trans_as_char = upper_move[upper_move.length() - 1];
-            result.trans_as = (trans_as_char == 'R') ? Color::RED : Color::BLUE;
-            result.valid = true;
-        }
-        else if (upper_move.length() >= 2)
-        {
-            result.hole = std::stoi(upper_move.substr(0, upper_move.length() - 1));
+            if (state.move_count < SELFPLAY_OPENING_PLIES)
+            {
+                auto moves = MoveGenerator::getAllMoves(state, player);
+                if (moves.empty())
+                {
+                    break;
+                }
+                move = moves[rng.below(static_cast<uint32_t>(moves.size()))];
+            }
+            else
+            {
+                move = bot.findBestMove(state, player, std::chrono::milliseconds(3600000));
+            }
 
-            char color_char = upper_move[upper_move.length() - 1];
-            result.color = (color_char == 'R') ? Color::RED : Color::BLUE;
-            result.valid = true;
+            if (!move.valid() || !engine.playMove(move))
+            {
+                break;
+            }
         }
-    }
-    catch (...)
-    {
-        result.valid = false;
+
+        total_moves += state.move_count;
+        wins[state.getWinner()]++;
+        std::cerr << "selfplay " << (game + 1) << "/" << games << ": " << state.move_count << " coups, "
+                  << state.captured_seeds[1] << "-" << state.captured_seeds[2] << std::endl;
     }
 
-    return result;
+    auto end_time = std::chrono::steady_clock::now();
+    long total_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cerr << "selfplay: " << games << " parties, " << total_moves << " coups, J1 " << wins[1] << " / J2 "
+              << wins[2] << " / nulles " << wins[0] << ", " << total_time << " ms" << std::endl;
+    return 0;
 }
 
-std::string format_move(int hole, Color color, std::optional<Color> trans_as)
+int run_analyze(const std::string &path, int depth, int time_ms, const EngineOptions &options)
 {
-    std::stringstream ss;
-    ss << hole;
+    /**
+    Analyse par lots: une position par ligne, en notation compacte (notation.h) ou
+    donnée par la suite de coups depuis le départ (ex: "1R 4B 3TR")
+    Lignes vides et commentaires '#' ignorés
+    Recherche à profondeur fixe (depth) ou à temps fixe (time_ms) sur un pool de threads
+    (options threads; l'option hash est partagée entre les tables des threads)
+    Sortie dans l'ordre du fichier: position, meilleur coup, score, profondeur, nœuds (tabulations)
+    */
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::cerr << "Impossible de lire " << path << std::endl;
+        return 1;
+    }
 
-    if (color == Color::TRANSPARENT && trans_as.has_value())
+    std::vector<std::string> positions;
+    std::string line;
+    while (std::getline(in, line))
     {
-        ss << "T" << (trans_as.value() == Color::RED ? "R" : "B");
+        line.erase(0, line.find_first_not_of(" \t\r\n"));
+        line.erase(line.find_last_not_of(" \t\r\n") + 1);
+        if (!line.empty() && line[0] != '#')
+        {
+            positions.push_back(line);
+        }
     }
-    else
+
+    std::chrono::milliseconds timeout(time_ms > 0 ? time_ms : 3600000);
+    std::vector<std::string> results(positions.size());
+    int threads = options.searchThreads();
+    EngineOptions thread_options = options;
+    thread_options.max_depth = depth;
+    thread_options.hash_mb = options.hash_mb / threads;
     {
-        ss << (color == Color::RED ? "R" : "B");
+        ThreadPool pool(threads);
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            pool.submit([&, i]()
+            {
+                // Une instance de recherche par thread, réutilisée d'une position à l'autre;
+                // table vidée à chaque position: le résultat ne dépend pas de l'ordre d'analyse
+                thread_local MinMaxBot bot(1);
+                thread_options.apply(bot);
+                bot.clearHash();
+                bot.evaluator.network = eval_network;
+
+                GameState state;
+                GameEngine engine(&state);
+                std::stringstream moves(positions[i]);
+                std::string token;
+                if (positions[i].find('/') != std::string::npos)
+                {
+                    if (!Notation::parse(positions[i].data(), positions[i].size(), state))
+                    {
+                        results[i] = positions[i] + "\tinvalide: notation";
+                        return;
+                    }
+                    moves.str("");
+                }
+                while (moves >> token)
+                {
+                    Move parsed = Move::parse(token.data(), token.size());
+                    if (!parsed.valid() || state.isGameOver() || !engine.playMove(parsed))
+                    {
+                        results[i] = positions[i] + "\tinvalide: " + token;
+                        return;
+                    }
+                }
+
+                if (state.isGameOver())
+                {
+                    results[i] = positions[i] + "\tterminée";
+                    return;
+                }
+
+                Move best = bot.findBestMove(state, state.current_player, timeout);
+                std::stringstream out;
+                out << positions[i] << "\t" << best.text() << "\t" << bot.stats.score
+                    << "\t" << bot.stats.depth_reached << "\t" << bot.stats.nodes;
+                results[i] = out.str();
+            });
+        }
+        pool.wait();
     }
 
-    return ss.str();
+    for (const std::string &result : results)
+    {
+        std::cout << result << "\n";
+    }
+    std::cout.flush();
+    return 0;
 }
 
 int main(int argc, char *argv[])
 {
-    if (argc < 2)
+    // Options: JoueurA|JoueurB, --selfplay-train [N], --profile (zones de profiler.h, sur stderr)
+    // --analyze fichier [--time ms], options du moteur (engine_options.h: MANCALA_CONFIG, --config,
+    // --threads, --hash, --movetime, --overhead, --depth, --nodes, --nnue)
+    EngineOptions options;
+    std::string error;
+    if (!options.loadEnvironment(error))
+    {
+        std::cerr << "MANCALA_CONFIG: " << error << std::endl;
+        return 1;
+    }
+
+    std::string player_name;
+    std::string analyze_path;
+    int analyze_time_ms = 0; // 0: pas de limite de temps (profondeur fixe)
+    int selfplay_games = 0;
+    bool profile = false;
+    for (int i = 1; i < argc; i++)
+    {
+        int used = options.parseArgument(argc, argv, i, error);
+        if (used < 0)
+        {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        if (used > 0)
+        {
+            i += used - 1;
+            continue;
+        }
+
+        std::string arg = argv[i];
+        if (arg == "--profile")
+        {
+            profile = true;
+        }
+        else if (arg == "--selfplay-train")
+        {
+            selfplay_games = (i + 1 < argc && argv[i + 1][0] != '-') ? std::max(1, std::atoi(argv[++i])) : 10;
+        }
+        else if (arg == "--analyze" && i + 1 < argc)
+        {
+            analyze_path = argv[++i];
+        }
+        else if (arg == "--time" && i + 1 < argc)
+        {
+            analyze_time_ms = std::max(1, std::atoi(argv[++i]));
+        }
+        else
+        {
+            player_name = arg;
+        }
+    }
+
+    static NnueNetwork network;
+    if (!options.nnue_path.empty())
+    {
+        if (network.load(options.nnue_path))
+        {
+            eval_network = &network;
+        }
+        else
+        {
+            // Jamais sur stdout (protocole): l'évaluation par poids reste active
+            std::cerr << "Réseau illisible: " << options.nnue_path << " (évaluation par poids)" << std::endl;
+        }
+    }
+
+    if (!analyze_path.empty())
+    {
+        // Profondeur 6 par défaut; à temps fixe sans --depth, bornée seulement par l'option depth
+        int analyze_depth = options.isSet(EngineOptions::DEPTH) || analyze_time_ms > 0 ? options.max_depth : 6;
+        int status = run_analyze(analyze_path, analyze_depth, analyze_time_ms, options);
+        if (profile)
+        {
+            Profiler::report(std::cerr);
+        }
+        return status;
+    }
+
+    if (selfplay_games > 0)
+    {
+        int status = run_selfplay_train(selfplay_games, options);
+        if (profile)
+        {
+            Profiler::report(std::cerr);
+        }
+        return status;
+    }
+
+    if (player_name.empty())
     {
         return 1;
     }
 
-    int my_player = (std::string(argv[1]) == "JoueurA") ? 1 : 2;
+    int my_player = (player_name == "JoueurA") ? 1 : 2;
 
     GameState state;
     GameEngine engine(&state);
     MinMaxBot bot(1);
+    options.apply(bot);
+    bot.evaluator.network = eval_network;
     int move_count = 0;
-    std::string last_move;
+    Move last_move;
 
-    std::string line;
+    // Protocole: tampons fixes, une réponse = un write()
+    ProtocolReader input(STDIN_FILENO);
+    ProtocolWriter output(STDOUT_FILENO);
+    const char *line;
+    size_t length;
+
+    // Journal de télémétrie: fichier LOG_FILE ou stderr, jamais stdout
+    std::ofstream log_file;
+    if (LOG_MOVES && LOG_FILE[0] != '\0')
+    {
+        log_file.open(LOG_FILE, std::ios::app);
+    }
+    std::ostream &log_out = log_file.is_open() ? static_cast<std::ostream &>(log_file) : std::cerr;
+    if (LOG_MOVES)
+    {
+        log_out << "{\"options\":\"" << options.summary() << "\"}" << std::endl;
+    }
 
-    auto check_game_over = [&]() -> std::string
+    // Journal binaire de la partie (game_log.h), écrit une seule fois: avant l'envoi de la dernière
+    // réponse (l'arbitre peut tuer le bot dès la fin de partie) ou à la fermeture de stdin
+    GameLogRecord game_record;
+    game_record.player1 = my_player == 1 ? "bot" : "adversaire";
+    game_record.player2 = my_player == 2 ? "bot" : "adversaire";
+    bool game_logged = false;
+
+    auto log_game = [&]()
     {
+        if (!LOG_GAMES || game_logged)
+        {
+            return;
+        }
+        game_logged = true;
+        GameLogWriter game_log(GAME_LOG_FILE);
+        game_record.setResult(state, state.isGameOver() ? GameLogEnd::NORMAL : GameLogEnd::ABORTED);
+        game_log.append(game_record);
+    };
+
+    auto check_game_over = [&]() -> bool
+    {
+        /**Ajoute la ligne RESULT à la réponse si la partie est finie*/
         int score_j1 = state.captured_seeds[1];
         int score_j2 = state.captured_seeds[2];
 
         if (score_j1 >= 49 || score_j2 >= 49)
         {
-            return "RESULT " + last_move + " " + std::to_string(score_j1) + " " + std::to_string(score_j2);
+            output.result(last_move, score_j1, score_j2);
+            return true;
         }
 
         if (move_count >= 400)
         {
-            return "RESULT LIMIT " + std::to_string(score_j1) + " " + std::to_string(score_j2);
+            output.resultLimit(score_j1, score_j2);
+            return true;
         }
 
-        int total_on_board = 0;
-        for (int i = 1; i <= 16; i++)
-        {
-            total_on_board += state.holes[i][Color::RED] + state.holes[i][Color::BLUE] + state.holes[i][Color::TRANSPARENT];
-        }
-        if (total_on_board < 10)
+        // Autres fins selon les règles (égalité, ...): même décision que l'arbitre (GameState::isGameOver)
+        if (state.getSeedsOnBoard() < 10 || state.isGameOver())
         {
-            return "RESULT " + last_move + " " + std::to_string(score_j1) + " " + std::to_string(score_j2);
+            output.result(last_move, score_j1, score_j2);
+            return true;
         }
 
-        return "";
+        return false;
     };
 
-    while (std::getline(std::cin, line))
+    while (input.nextLine(line, length))
     {
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
+        bool start = length == 5 && std::memcmp(line, "START", 5) == 0;
 
-        if (line == "START" && my_player == 2)
+        if (start && my_player == 2)
         {
             continue;
         }
 
-        if (line != "START")
+        if (!start)
         {
-            ParsedMove parsed = parse_move(line);
-            if (parsed.valid)
+            Move parsed = Move::parse(line, length);
+            if (parsed.valid())
             {
-                if (parsed.color == Color::TRANSPARENT && parsed.trans_as.has_value())
-                {
-                    engine.playMove(parsed.hole, parsed.color, parsed.trans_as.value(), true);
-                }
-                else
-                {
-                    engine.playMove(parsed.hole, parsed.color, Color::RED, false);
-                }
+                engine.playMove(parsed);
+                game_record.addMove(parsed, 0.0);
                 move_count++;
-                last_move = line;
+                last_move = parsed;
 
-                std::string result = check_game_over();
-                if (!result.empty())
+                if (check_game_over())
                 {
-                    std::cout << result << std::endl;
+                    log_game();
+                    output.flush();
                     break;
                 }
             }
@@ -153,41 +388,52 @@ int main(int argc, char *argv[])
 
         auto start_time = std::chrono::steady_clock::now();
 
-        Move best_move = bot.findBestMove(state, my_player, std::chrono::milliseconds(2000));
+        Move best_move = bot.findBestMove(state, my_player, options.moveBudget());
 
         auto end_time = std::chrono::steady_clock::now();
-        long total_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
-
-        std::string my_move;
 
-        if (best_move.valid)
+        if (best_move.valid())
         {
-            std::optional<Color> trans_opt = best_move.use_transparent ? std::optional<Color>(best_move.transparent_as) : std::nullopt;
-            my_move = format_move(best_move.hole, best_move.color, trans_opt);
-
-            engine.playMove(best_move.hole, best_move.color,
-                            best_move.transparent_as, best_move.use_transparent);
+            engine.playMove(best_move);
             move_count++;
-            last_move = my_move;
+            last_move = best_move;
+
+            // Le coup et, si la partie est finie, la ligne RESULT partent ensemble
+            output.move(best_move);
+            bool game_over = check_game_over();
+            game_record.addMove(best_move, std::chrono::duration<double>(end_time - start_time).count());
+            if (game_over)
+            {
+                log_game();
+            }
+            output.flush();
 
-            std::cout << my_move << std::endl;
-            std::cout.flush();
+            if (LOG_MOVES)
+            {
+                log_out << bot.stats.toJson(move_count, best_move.text()) << std::endl;
+            }
 
-            std::string result = check_game_over();
-            if (!result.empty())
+            if (game_over)
             {
-                std::cout << result << std::endl;
                 break;
             }
         }
         else
         {
-            int score_j1 = state.captured_seeds[1];
-            int score_j2 = state.captured_seeds[2];
-            std::cout << "RESULT " << last_move << " " << score_j1 << " " << score_j2 << std::endl;
+            output.result(last_move, state.captured_seeds[1], state.captured_seeds[2]);
+            log_game();
+            output.flush();
             break;
         }
     }
 
+    // stdin fermé (fin de partie vue par l'arbitre): la partie est journalisée telle que connue
+    log_game();
+
+    if (profile)
+    {
+        Profiler::report(std::cerr);
+    }
+
     return 0;
 }
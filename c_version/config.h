@@ -15,9 +15,11 @@
 // 5+: très lent, pas recommandé
 const int AI_DEPTH = 3;
 
-// Poids dans l'évaluation des positions
-const int SCORE_WEIGHT = 10;      // Poids pour la différence de graines capturées
-const int BOARD_WEIGHT = 2;       // Poids pour la différence de graines sur le plateau
+// Poids dans l'évaluation des positions: eval_weights.h (généré par tune_eval)
+
+// Évaluation par réseau (nnue.h): fichier de poids écrit par `tune_eval --nnue`
+// Chaîne vide: évaluation par les poids de eval_weights.h (valeur par défaut de l'option nnue)
+const char *const NNUE_FILE = "";
 
 // ==================== DEBUG ====================
 
@@ -30,6 +32,7 @@ const bool SHOW_BOARD_STATE = false;
 // ==================== TIMING ====================
 
 // Temps maximum par coup (en secondes) - à adapter selon la plateforme
+// Valeur par défaut de l'option movetime du bot (engine_options.h), marge comprise
 const double MAX_TIME_PER_MOVE = 3.0;
 
 // ==================== STRATÉGIE ====================
@@ -43,8 +46,16 @@ const double MAX_TIME_PER_MOVE = 3.0;
 // ==================== LOGGING ====================
 
 // Enregistrer les mouvements dans un fichier (pour debug)
+// Une ligne JSON par coup: profondeur, nœuds, NPS, temps par itération,
+// facteur de branchement effectif, taux de coupure au premier coup...
+// Jamais sur stdout (réservé au protocole de l'arbitre)
 const bool LOG_MOVES = false;
-// const char* LOG_FILE = "bot_moves.log";
+// Fichier du journal (ajout en fin); chaîne vide = stderr
+const char *const LOG_FILE = "bot_moves.log";
+
+// Journal binaire des parties (game_log.h): coups sur 1 octet, temps, joueurs, résultat
+const bool LOG_GAMES = false;
+const char *const GAME_LOG_FILE = "games.mlog";
 
 // ==================== PLATEFORME ====================
 
@@ -93,6 +104,11 @@ const int CAPTURE_MAX = 3;
 const int WINNING_SEEDS = 49;          // Graine pour victoire
 const int DRAW_THRESHOLD = 40;         // Égalité si les deux joueurs ont 40+
 const int GAME_END_SEEDS = 10;         // Fin si moins de 10 graines sur le plateau
+const int MAX_GAME_MOVES = 400;        // Limite de coups (200 par joueur)
+
+// Ces valeurs forment StandardRules (game_rules.h), les règles de la partie arbitrée.
+// Une variante (12 ou 20 trous, autre nombre de graines...) est un autre RuleSet:
+// tout le moteur est instancié pour elle, sans copie du code
 
 // Joueurs
 const int PLAYER_1 = 0;
@@ -0,0 +1,261 @@
+/**
+ * Options du moteur à l'exécution: même binaire, ressources dimensionnées sur la machine
+ *
+ * Ordre de priorité (le dernier l'emporte):
+ *     valeurs par défaut (config.h)
+ *     fichier désigné par la variable d'environnement MANCALA_CONFIG
+ *     fichier passé par --config
+ *     options de la ligne de commande (--threads 8, --hash 256, ...)
+ *
+ * Fichier: une option par ligne, "clé = valeur"; lignes vides et commentaires '#' ignorés
+ *     threads   threads de calcul (0: un par cœur)
+ *     hash      table de transposition de MinMaxBot, en Mo (0: sans table)
+ *     movetime  temps accordé par coup par l'arbitre, en ms
+ *     overhead  marge retirée de movetime (lecture, écriture, latence de l'arbitre), en ms
+ *     depth     profondeur maximale de l'approfondissement itératif
+ *     nodes     budget de nœuds par coup (0: aucun)
+ *     nnue      fichier de poids du réseau d'évaluation (vide: évaluation par poids)
+ * Toute erreur (clé inconnue, valeur invalide) est signalée avec sa provenance.
+ */
+
+#ifndef ENGINE_OPTIONS_H
+#define ENGINE_OPTIONS_H
+
+#include "ai_algorithms.h"
+#include "config.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+class EngineOptions
+{
+public:
+    enum Key
+    {
+        THREADS,
+        HASH,
+        MOVETIME,
+        OVERHEAD,
+        DEPTH,
+        NODES,
+        NNUE,
+        KEY_COUNT
+    };
+
+    int threads = 0;
+    int hash_mb = 16;
+    int move_time_ms = static_cast<int>(MAX_TIME_PER_MOVE * 1000);
+    int move_overhead_ms = 1000;
+    int max_depth = 20;
+    long nodes = 0;
+    std::string nnue_path = NNUE_FILE;
+
+    bool set(const std::string &key, const std::string &value, std::string &error)
+    {
+        /**Affecte une option par son nom (celui du fichier, sans "--"); false et error si invalide*/
+        int k = find(key);
+        if (k < 0)
+        {
+            error = "option inconnue: " + key;
+            return false;
+        }
+        if (k == NNUE)
+        {
+            nnue_path = value;
+        }
+        else
+        {
+            long number;
+            if (!parseNumber(value, KEYS[k].min, KEYS[k].max, number))
+            {
+                error = "valeur invalide pour " + key + ": \"" + value + "\" (de " + std::to_string(KEYS[k].min) +
+                        " à " + std::to_string(KEYS[k].max) + ")";
+                return false;
+            }
+            switch (k)
+            {
+            case THREADS:
+                threads = static_cast<int>(number);
+                break;
+            case HASH:
+                hash_mb = static_cast<int>(number);
+                break;
+            case MOVETIME:
+                move_time_ms = static_cast<int>(number);
+                break;
+            case OVERHEAD:
+                move_overhead_ms = static_cast<int>(number);
+                break;
+            case DEPTH:
+                max_depth = static_cast<int>(number);
+                break;
+            case NODES:
+                nodes = number;
+                break;
+            }
+        }
+        set_mask |= 1u << k;
+        return true;
+    }
+
+    bool isSet(Key key) const
+    {
+        /**Option donnée explicitement (fichier ou ligne de commande)*/
+        return (set_mask >> key) & 1;
+    }
+
+    bool loadFile(const std::string &path, std::string &error)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            error = "fichier illisible: " + path;
+            return false;
+        }
+        std::string line;
+        int number = 0;
+        while (std::getline(in, line))
+        {
+            number++;
+            line = trim(line.substr(0, line.find('#')));
+            if (line.empty())
+            {
+                continue;
+            }
+            size_t eq = line.find('=');
+            if (eq == std::string::npos || !set(trim(line.substr(0, eq)), trim(line.substr(eq + 1)), error))
+            {
+                error = path + ":" + std::to_string(number) + ": " + (eq == std::string::npos ? "\"clé = valeur\" attendu" : error);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool loadEnvironment(std::string &error)
+    {
+        /**Fichier désigné par MANCALA_CONFIG, s'il est défini*/
+        const char *path = std::getenv("MANCALA_CONFIG");
+        return !path || path[0] == '\0' || loadFile(path, error);
+    }
+
+    int parseArgument(int argc, char *argv[], int i, std::string &error)
+    {
+        /**
+        Lit l'option argv[i] ("--hash 64", "--config fichier")
+        Retourne le nombre d'arguments consommés: 0 si argv[i] n'est pas une option du moteur,
+        -1 en cas d'erreur (error renseigné)
+        */
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0)
+        {
+            return 0;
+        }
+        std::string name = arg.substr(2);
+        bool config = name == "config";
+        if (!config && find(name) < 0)
+        {
+            return 0;
+        }
+        if (i + 1 >= argc)
+        {
+            error = arg + ": valeur attendue";
+            return -1;
+        }
+        bool ok = config ? loadFile(argv[i + 1], error) : set(name, argv[i + 1], error);
+        return ok ? 2 : -1;
+    }
+
+    int searchThreads() const
+    {
+        /**threads <= 0: un par cœur*/
+        int n = threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency());
+        return std::max(1, n);
+    }
+
+    std::chrono::milliseconds moveBudget() const
+    {
+        /**Temps de recherche d'un coup: movetime moins la marge, 1 ms au moins*/
+        return std::chrono::milliseconds(std::max(1, move_time_ms - move_overhead_ms));
+    }
+
+    void apply(MinMaxBot &bot) const
+    {
+        /**Limites de recherche et table de transposition (réallouée seulement si la taille change)*/
+        bot.max_depth = max_depth;
+        bot.node_limit = nodes;
+        if (bot.hashSize() != hash_mb)
+        {
+            bot.setHashSize(hash_mb);
+        }
+    }
+
+    std::string summary() const
+    {
+        std::ostringstream out;
+        out << "threads=" << searchThreads() << " hash=" << hash_mb << "Mo movetime=" << move_time_ms
+            << "ms overhead=" << move_overhead_ms << "ms depth=" << max_depth << " nodes=" << nodes
+            << " nnue=" << (nnue_path.empty() ? "-" : nnue_path);
+        return out.str();
+    }
+
+    static std::string usage()
+    {
+        return "[--config fichier] [--threads N] [--hash Mo] [--movetime ms] [--overhead ms] [--depth N]"
+               " [--nodes N] [--nnue fichier]";
+    }
+
+private:
+    struct KeyInfo
+    {
+        const char *name;
+        long min;
+        long max;
+    };
+
+    static constexpr KeyInfo KEYS[KEY_COUNT] = {
+        {"threads", 0, 1024},
+        {"hash", 0, 1 << 16},
+        {"movetime", 1, 3600000},
+        {"overhead", 0, 3600000},
+        {"depth", 1, 64},
+        {"nodes", 0, 1L << 40},
+        {"nnue", 0, 0},
+    };
+
+    uint32_t set_mask = 0;
+
+    static int find(const std::string &name)
+    {
+        for (int k = 0; k < KEY_COUNT; k++)
+        {
+            if (name == KEYS[k].name)
+            {
+                return k;
+            }
+        }
+        return -1;
+    }
+
+    static bool parseNumber(const std::string &text, long min, long max, long &value)
+    {
+        errno = 0;
+        char *end = nullptr;
+        value = std::strtol(text.c_str(), &end, 10);
+        return !text.empty() && errno == 0 && *end == '\0' && value >= min && value <= max;
+    }
+
+    static std::string trim(const std::string &text)
+    {
+        size_t first = text.find_first_not_of(" \t\r\n");
+        size_t last = text.find_last_not_of(" \t\r\n");
+        return first == std::string::npos ? std::string() : text.substr(first, last - first + 1);
+    }
+};
+
+#endif // ENGINE_OPTIONS_H
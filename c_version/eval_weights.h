@@ -0,0 +1,23 @@
+/**
+ * Poids de l'évaluation (Evaluator::evaluateWeights), un entier par caractéristique EvalFeature
+ * Fichier généré par tune_eval: ne pas modifier à la main, relancer l'ajustement
+ *
+ * Valeurs de départ: les poids historiques (10 par graine capturée, 2 par graine dans son camp)
+ */
+
+#ifndef EVAL_WEIGHTS_H
+#define EVAL_WEIGHTS_H
+
+const int EVAL_WEIGHTS[] = {
+    10, // EVAL_CAPTURED
+    2,  // EVAL_BOARD
+    0,  // EVAL_VULNERABLE
+    0,  // EVAL_EMPTY
+    0,  // EVAL_TRANSPARENT
+    0,  // EVAL_TRANSPARENT_HOLES
+    0,  // EVAL_MOBILITY
+    0,  // EVAL_NEAR_WIN
+    0,  // EVAL_DRAW_LINE
+};
+
+#endif // EVAL_WEIGHTS_H
@@ -1,29 +1,288 @@
 /**
  * Moteur de jeu Mancala - Version CORRIGÉE avec règles complètes de capture
  * Les graines transparentes sont distribuées AVANT les autres graines de la couleur désignée
+ *
+ * Semis vectoriel: chaque couleur du plateau tient dans un vecteur de 16 octets.
+ * Un semis est l'ajout d'un vecteur d'incréments précalculé (SOW_TABLE).
+ * Captures: la chaîne de trous à 2-3 graines est résolue sur un masque de 16 bits.
+ *
+ * BasicGameEngine et BasicMoveGenerator sont instanciés par RuleSet (game_rules.h): tables,
+ * masques et seuils d'une variante sont des constantes; un plateau de plus de 16 trous
+ * occupe plusieurs vecteurs par couleur. GameEngine / MoveGenerator: règles standard.
  */
 
 #ifndef GAME_ENGINE_H
 #define GAME_ENGINE_H
 
 #include "game_rules.h"
+#include "move.h"
+#include "profiler.h"
 #include <vector>
-#include <tuple>
 #include <algorithm>
 #include <iostream>
 
-class GameEngine
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MANCALA_SSE2 1
+#endif
+
+// Opérations sur un plan de 16 octets (une couleur, 16 trous)
+inline void planeAdd(uint8_t *plane, const uint8_t *inc)
+{
+#ifdef MANCALA_SSE2
+    __m128i p = _mm_load_si128(reinterpret_cast<const __m128i *>(plane));
+    __m128i v = _mm_load_si128(reinterpret_cast<const __m128i *>(inc));
+    _mm_store_si128(reinterpret_cast<__m128i *>(plane), _mm_add_epi8(p, v));
+#else
+    for (int i = 0; i < 16; i++)
+    {
+        plane[i] = static_cast<uint8_t>(plane[i] + inc[i]);
+    }
+#endif
+}
+
+inline void planeAddDiff(uint8_t *plane, const uint8_t *hi, const uint8_t *lo)
+{
+    /**plane += hi - lo*/
+#ifdef MANCALA_SSE2
+    __m128i p = _mm_load_si128(reinterpret_cast<const __m128i *>(plane));
+    __m128i h = _mm_load_si128(reinterpret_cast<const __m128i *>(hi));
+    __m128i l = _mm_load_si128(reinterpret_cast<const __m128i *>(lo));
+    _mm_store_si128(reinterpret_cast<__m128i *>(plane), _mm_add_epi8(p, _mm_sub_epi8(h, l)));
+#else
+    for (int i = 0; i < 16; i++)
+    {
+        plane[i] = static_cast<uint8_t>(plane[i] + hi[i] - lo[i]);
+    }
+#endif
+}
+
+template <int Plane>
+inline void planeTotals(const uint8_t (*seeds)[Plane], uint8_t *totals)
+{
+    /**totals = rouge + bleu + transparent, trou par trou*/
+    for (int v = 0; v < Plane; v += 16)
+    {
+#ifdef MANCALA_SSE2
+        __m128i r = _mm_load_si128(reinterpret_cast<const __m128i *>(seeds[0] + v));
+        __m128i b = _mm_load_si128(reinterpret_cast<const __m128i *>(seeds[1] + v));
+        __m128i t = _mm_load_si128(reinterpret_cast<const __m128i *>(seeds[2] + v));
+        _mm_store_si128(reinterpret_cast<__m128i *>(totals + v), _mm_add_epi8(_mm_add_epi8(r, b), t));
+#else
+        for (int i = v; i < v + 16; i++)
+        {
+            totals[i] = static_cast<uint8_t>(seeds[0][i] + seeds[1][i] + seeds[2][i]);
+        }
+#endif
+    }
+}
+
+template <int CaptureMin = 2, int CaptureMax = 3>
+inline uint32_t planeCaptureMask(const uint8_t *totals)
+{
+    /**Masque 16 bits des trous contenant de CaptureMin à CaptureMax graines, 2 ou 3 en standard (bit i = trou i + 1)*/
+#ifdef MANCALA_SSE2
+    // total - min <= max - min, en non signé
+    __m128i t = _mm_load_si128(reinterpret_cast<const __m128i *>(totals));
+    __m128i above_min = _mm_sub_epi8(t, _mm_set1_epi8(CaptureMin));
+    __m128i in_range = _mm_cmpeq_epi8(_mm_min_epu8(above_min, _mm_set1_epi8(CaptureMax - CaptureMin)), above_min);
+    return static_cast<uint32_t>(_mm_movemask_epi8(in_range));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        mask |= static_cast<uint32_t>(static_cast<uint8_t>(totals[i] - CaptureMin) <= CaptureMax - CaptureMin) << i;
+    }
+    return mask;
+#endif
+}
+
+template <int Plane>
+inline int planeClearMasked(uint8_t (*seeds)[Plane], const uint8_t *totals, uint32_t mask)
+{
+    /**Vide les trous du masque dans les trois couleurs et retourne la somme de leurs graines*/
+    int total = 0;
+    for (int v = 0; v < Plane; v += 16)
+    {
+        uint32_t lanes = (mask >> v) & 0xFFFF;
+#ifdef MANCALA_SSE2
+        // Développe les 16 bits du masque en 16 octets 0x00 / 0xFF
+        const __m128i bit_of_lane = _mm_set_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+        __m128i spread = _mm_unpacklo_epi64(_mm_set1_epi8(static_cast<char>(lanes & 0xFF)),
+                                            _mm_set1_epi8(static_cast<char>(lanes >> 8)));
+        __m128i bytes = _mm_cmpeq_epi8(_mm_and_si128(spread, bit_of_lane), bit_of_lane);
+
+        __m128i t = _mm_load_si128(reinterpret_cast<const __m128i *>(totals + v));
+        __m128i sums = _mm_sad_epu8(_mm_and_si128(t, bytes), _mm_setzero_si128());
+        total += _mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4);
+
+        for (int c = 0; c < 3; c++)
+        {
+            __m128i *plane = reinterpret_cast<__m128i *>(seeds[c] + v);
+            _mm_store_si128(plane, _mm_andnot_si128(bytes, _mm_load_si128(plane)));
+        }
+#else
+        for (int i = 0; i < 16; i++)
+        {
+            uint8_t keep = static_cast<uint8_t>(((lanes >> i) & 1) - 1); // 0xFF si conservé, 0x00 si capturé
+            total += totals[v + i] & ~keep;
+            seeds[0][v + i] &= keep;
+            seeds[1][v + i] &= keep;
+            seeds[2][v + i] &= keep;
+        }
+#endif
+    }
+    return total;
+}
+
+inline void planeBoardFeatures(const uint8_t *red, const uint8_t *blue, const uint8_t *transparent,
+                               BoardFeatures &features)
+{
+    /**
+    Résumé des deux camps (voir BoardFeatures) sur 16 trous, recalculé en une passe vectorielle
+    Chaque trou donne des compteurs par octet, sommés par parité de trou: vus comme mots
+    de 16 bits, octet pair (J1) + 256 * octet impair (J2); les vecteurs sont sommés
+    ensemble par transposition (aucun popcount, absent de la cible x86-64 de base)
+    */
+#ifdef MANCALA_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    __m128i r = _mm_load_si128(reinterpret_cast<const __m128i *>(red));
+    __m128i b = _mm_load_si128(reinterpret_cast<const __m128i *>(blue));
+    __m128i t = _mm_load_si128(reinterpret_cast<const __m128i *>(transparent));
+    __m128i totals = _mm_add_epi8(_mm_add_epi8(r, b), t);
+
+    __m128i has_red = _mm_andnot_si128(_mm_cmpeq_epi8(r, zero), one);
+    __m128i has_blue = _mm_andnot_si128(_mm_cmpeq_epi8(b, zero), one);
+    __m128i has_transparent = _mm_andnot_si128(_mm_cmpeq_epi8(t, zero), one);
+    __m128i moves = _mm_add_epi8(_mm_add_epi8(has_red, has_blue), _mm_add_epi8(has_transparent, has_transparent));
+
+    // total - 1 <= 1 (non signé): 1 ou 2 graines; vides dans le quartet haut (8 trous au plus par camp)
+    __m128i minus_one = _mm_sub_epi8(totals, one);
+    __m128i is_vulnerable = _mm_and_si128(_mm_cmpeq_epi8(_mm_min_epu8(minus_one, one), minus_one), one);
+    __m128i is_empty = _mm_and_si128(_mm_cmpeq_epi8(totals, zero), _mm_set1_epi8(16));
+    __m128i holes = _mm_or_si128(is_vulnerable, is_empty);
+
+    // Sommes horizontales des mots de 16 bits (chaque somme d'octets par camp reste < 256)
+    __m128i v01 = _mm_add_epi16(_mm_unpacklo_epi16(totals, t), _mm_unpackhi_epi16(totals, t));
+    __m128i v23 = _mm_add_epi16(_mm_unpacklo_epi16(moves, holes), _mm_unpackhi_epi16(moves, holes));
+    __m128i v4 = _mm_add_epi16(_mm_unpacklo_epi16(has_transparent, zero), _mm_unpackhi_epi16(has_transparent, zero));
+    __m128i v0123 = _mm_add_epi16(_mm_unpacklo_epi32(v01, v23), _mm_unpackhi_epi32(v01, v23));
+    v4 = _mm_add_epi16(_mm_unpacklo_epi32(v4, zero), _mm_unpackhi_epi32(v4, zero));
+    v0123 = _mm_add_epi16(v0123, _mm_srli_si128(v0123, 8));
+    v4 = _mm_add_epi16(v4, _mm_srli_si128(v4, 8));
+
+    // Octets: graines, transparentes, mobilité, (vulnérables | vides << 4), trous à transparentes
+    uint64_t sums;
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(&sums), v0123);
+    uint16_t packed = static_cast<uint16_t>(sums >> 48);
+    uint16_t vulnerable = packed & 0x0F0F;
+    uint16_t empty = (packed >> 4) & 0x0F0F;
+    uint16_t transparent_holes = static_cast<uint16_t>(_mm_cvtsi128_si32(v4));
+    std::memcpy(features.seeds, &sums, 6); // seeds, transparent, mobility
+    std::memcpy(features.vulnerable, &vulnerable, 2);
+    std::memcpy(features.empty, &empty, 2);
+    std::memcpy(features.transparent_holes, &transparent_holes, 2);
+#else
+    features = BoardFeatures{};
+    for (int i = 0; i < 16; i++)
+    {
+        int side = i & 1;
+        int total = red[i] + blue[i] + transparent[i];
+        int has_transparent = transparent[i] != 0;
+        features.seeds[side] += total;
+        features.transparent[side] += transparent[i];
+        features.mobility[side] += (red[i] != 0) + (blue[i] != 0) + 2 * has_transparent;
+        features.vulnerable[side] += (total == 1 || total == 2);
+        features.empty[side] += (total == 0);
+        features.transparent_holes[side] += has_transparent;
+    }
+#endif
+}
+
+template <int Plane>
+inline void planeBoardFeatures(const uint8_t (*seeds)[Plane], BoardFeatures &features)
+{
+    /**
+    Résumé des deux camps, vecteur par vecteur (16 est pair: la parité du trou donne le camp)
+    Les octets au-delà du plateau comptent comme trous vides (corrigé par BasicGameEngine)
+    */
+    planeBoardFeatures(seeds[0], seeds[1], seeds[2], features);
+    for (int v = 16; v < Plane; v += 16)
+    {
+        BoardFeatures more;
+        planeBoardFeatures(seeds[0] + v, seeds[1] + v, seeds[2] + v, more);
+        uint8_t *sum = &features.seeds[0];
+        const uint8_t *add = &more.seeds[0];
+        for (size_t k = 0; k < sizeof(BoardFeatures); k++)
+        {
+            sum[k] = static_cast<uint8_t>(sum[k] + add[k]);
+        }
+    }
+}
+
+template <class Rules>
+struct BasicSowTable
+{
+    /**
+    Vecteurs d'incréments d'un semis, indexés par (trou de départ, règle, nombre de graines)
+    - règle 0 (rouge): la k-ième graine va dans le trou départ + 1 + k (tous les trous)
+    - règle 1 (bleu): la k-ième graine va dans le k-ième trou adverse (période HOLES_PER_PLAYER)
+    Le joueur est implicite: c'est le propriétaire du trou de départ.
+    Un coup sème au plus toutes les transparentes et toutes les graines de la couleur désignée
+    (64 en standard: 32 + 32).
+    */
+    static constexpr int HOLES = Rules::HOLES;
+    static constexpr int PLANE = Rules::PLANE;
+    static constexpr int MAX_SEEDS = 2 * Rules::SEEDS_PER_COLOR * HOLES;
+
+    alignas(16) uint8_t inc[HOLES][2][MAX_SEEDS + 1][PLANE];
+    int8_t last[HOLES][2][MAX_SEEDS + 1]; // indice (0 à HOLES - 1) du dernier trou semé, -1 si aucune graine
+
+    constexpr BasicSowTable() : inc{}, last{}
+    {
+        for (int src = 0; src < HOLES; src++)
+        {
+            for (int rule = 0; rule < 2; rule++)
+            {
+                last[src][rule][0] = -1;
+                for (int n = 1; n <= MAX_SEEDS; n++)
+                {
+                    int k = n - 1;
+                    int hole = (rule == 0) ? (src + 1 + k) % HOLES
+                                           : (src + 1 + 2 * (k % Rules::HOLES_PER_PLAYER)) % HOLES;
+                    for (int i = 0; i < PLANE; i++)
+                    {
+                        inc[src][rule][n][i] = inc[src][rule][n - 1][i];
+                    }
+                    inc[src][rule][n][hole]++;
+                    last[src][rule][n] = static_cast<int8_t>(hole);
+                }
+            }
+        }
+    }
+};
+
+template <class Rules>
+inline constexpr BasicSowTable<Rules> SOW_TABLE{};
+
+template <class Rules>
+class BasicGameEngine
 {
 public:
-    GameState *state;
+    using State = BasicGameState<Rules>;
+    static constexpr int HOLES = Rules::HOLES;
+    static constexpr int PLANE = Rules::PLANE;
+
+    State *state;
     bool debug; // Mettre à true pour voir le détail des captures
 
-    GameEngine(GameState *game_state) : state(game_state), debug(false) {}
+    BasicGameEngine(State *game_state) : state(game_state), debug(false) {}
 
     int nextHole(int current_hole) const
     {
         /**Retourne le trou suivant en sens horaire*/
-        if (current_hole == 16)
+        if (current_hole == HOLES)
         {
             return 1;
         }
@@ -38,7 +297,7 @@ public:
         /**Retourne le trou précédent (sens anti-horaire)*/
         if (current_hole == 1)
         {
-            return 16;
+            return HOLES;
         }
         else
         {
@@ -48,9 +307,90 @@ public:
 
     bool isOpponentHole(int hole, int player) const
     {
-        /**Vérifie si un trou appartient à l'adversaire*/
-        std::vector<int> player_holes = state->getPlayerHoles(player);
-        return std::find(player_holes.begin(), player_holes.end(), hole) == player_holes.end();
+        /**Vérifie si un trou appartient à l'adversaire (joueur 1: impairs, joueur 2: pairs)*/
+        return (hole % 2 == 1) != (player == 1);
+    }
+
+    static int sow(uint8_t (*seeds)[PLANE], int src, int rule, bool transparent)
+    {
+        /**
+        Vide le trou src (indice 0 à HOLES - 1) pour la couleur `rule` (0 = rouge, 1 = bleu),
+        plus les transparentes si `transparent`, et sème sans boucle:
+        - transparentes: + inc[t]          (semées en premier)
+        - couleur:       + inc[t + c] - inc[t]
+        Retourne l'indice du dernier trou semé (-1 si aucune graine)
+        */
+        PROFILE_ZONE(PROFILE_SOW);
+        uint8_t *color_plane = seeds[rule];
+        int trans = transparent ? seeds[2][src] : 0;
+        int total = trans + color_plane[src];
+
+        color_plane[src] = 0;
+        seeds[2][src] = static_cast<uint8_t>(seeds[2][src] - trans);
+
+        const BasicSowTable<Rules> &table = SOW_TABLE<Rules>;
+        const uint8_t *inc_trans = table.inc[src][rule][trans];
+        const uint8_t *inc_total = table.inc[src][rule][total];
+        for (int v = 0; v < PLANE; v += 16)
+        {
+            planeAdd(seeds[2] + v, inc_trans + v);
+            planeAddDiff(color_plane + v, inc_total + v, inc_trans + v);
+        }
+
+        return table.last[src][rule][total];
+    }
+
+    static int capture(uint8_t (*seeds)[PLANE], int last, uint32_t *captured_holes = nullptr)
+    {
+        /**
+        Résout la chaîne de capture depuis le trou `last` (indice 0 à HOLES - 1), sans boucle ni branchement:
+        - masque de HOLES bits des trous à 2 ou 3 graines (CAPTURE_MIN à CAPTURE_MAX)
+        - rotation qui place `last` au bit de poids fort, les trous précédents (sens anti-horaire) en dessous
+        - la chaîne capturée est la suite de 1 de poids fort
+        - le total capturé est une somme masquée des totaux
+        Retourne le nombre de graines capturées
+        */
+        PROFILE_ZONE(PROFILE_CAPTURE);
+        alignas(16) uint8_t totals[PLANE];
+        planeTotals(seeds, totals);
+        uint32_t mask = 0;
+        for (int v = 0; v < PLANE; v += 16)
+        {
+            mask |= planeCaptureMask<Rules::CAPTURE_MIN, Rules::CAPTURE_MAX>(totals + v) << v;
+        }
+
+        // Bit HOLES - 1 = trou last, bit HOLES - 2 = trou last - 1, ..., bit 0 = trou last + 1
+        uint64_t doubled = mask | (static_cast<uint64_t>(mask) << HOLES);
+        uint32_t chain = static_cast<uint32_t>(doubled >> (last + 1)) & Rules::HOLE_MASK;
+        int length = __builtin_clz(~(chain << (32 - HOLES))); // suite de 1 de poids fort (0 à HOLES)
+
+        // Retour à la numérotation des trous: rotation inverse de la suite capturée
+        uint32_t run = static_cast<uint32_t>((uint64_t{Rules::HOLE_MASK} << (HOLES - length)) & Rules::HOLE_MASK);
+        uint32_t captured = ((run << (last + 1)) | (run >> (HOLES - 1 - last))) & Rules::HOLE_MASK;
+
+        if (captured_holes)
+        {
+            *captured_holes = captured;
+        }
+        return planeClearMasked(seeds, totals, captured);
+    }
+
+    static void updateFeatures(const uint8_t (*seeds)[PLANE], BoardFeatures &features)
+    {
+        /**Résumé des camps (planeBoardFeatures), sans les octets au-delà du plateau*/
+        constexpr int padding = (PLANE - HOLES) / 2; // par camp
+        planeBoardFeatures(seeds, features);
+        if constexpr (padding > 0)
+        {
+            features.empty[0] -= padding;
+            features.empty[1] -= padding;
+        }
+    }
+
+    bool playMove(Move move)
+    {
+        /**Exécute un coup codé sur un octet (voir move.h)*/
+        return move.valid() && playMove(move.hole(), move.color(), move.transparentAs(), move.useTransparent());
     }
 
     bool playMove(int hole, Color color, Color transparent_as = Color::RED, bool use_transparent = false)
@@ -68,13 +408,15 @@ public:
         int player = state->current_player;
 
         // Vérification de validité
-        if (state->holes[hole][color] == 0)
+        if (hole < 1 || hole > HOLES || isOpponentHole(hole, player))
         {
             return false;
         }
 
-        std::vector<int> player_holes = state->getPlayerHoles(player);
-        if (std::find(player_holes.begin(), player_holes.end(), hole) == player_holes.end())
+        uint8_t(*seeds)[PLANE] = state->holes.seeds;
+        int src = hole - 1;
+
+        if (seeds[static_cast<int>(color)][src] == 0)
         {
             return false;
         }
@@ -84,154 +426,50 @@ public:
             return false;
         }
 
-        int last_hole_seeded = -1;
-        Color distribution_rule;
+        // Règle de distribution: la couleur jouée, ou la couleur désignée pour les transparentes
+        bool transparent = (color == Color::TRANSPARENT);
+        Color distribution_rule = transparent ? transparent_as : color;
 
-        // Déterminer les graines à distribuer
-        if (color == Color::TRANSPARENT)
+        if (debug)
         {
-            // Les graines transparentes + les graines de la couleur désignée sont distribuées ensemble
-            int trans_seeds = state->holes[hole][Color::TRANSPARENT];
-            int color_seeds = state->holes[hole][transparent_as];
-
-            distribution_rule = transparent_as; // Règle de distribution (RED ou BLUE)
-
-            int seeds_transparent = trans_seeds;
-            int seeds_colored = color_seeds;
-
-            state->holes[hole][Color::TRANSPARENT] = 0;
-            state->holes[hole][transparent_as] = 0;
-
-            if (debug)
-            {
-                std::cout << "\n[DEBUG] Joueur " << player << " joue trou " << hole
-                          << ", TRANSPARENT comme " << colorToString(transparent_as) << std::endl;
-                std::cout << "[DEBUG] Graines transparentes: " << seeds_transparent
-                          << ", Graines " << colorToString(transparent_as) << ": " << seeds_colored << std::endl;
-            }
-
-            // Distribution spéciale: transparentes d'abord, puis colorées
-            int trans_remaining = seeds_transparent;
-            int colored_remaining = seeds_colored;
-            int current_hole = hole;
-
-            while (trans_remaining > 0 || colored_remaining > 0)
-            {
-                current_hole = nextHole(current_hole);
-
-                // Déterminer quelle graine distribuer (transparente d'abord)
-                Color current_seed_color;
-                if (trans_remaining > 0)
-                {
-                    current_seed_color = Color::TRANSPARENT;
-                    trans_remaining--;
-                }
-                else
-                {
-                    current_seed_color = transparent_as;
-                    colored_remaining--;
-                }
-
-                // Distribution selon les règles
-                if (distribution_rule == Color::RED)
-                {
-                    // Les rouges vont dans tous les trous
-                    state->holes[current_hole][current_seed_color]++;
-                    last_hole_seeded = current_hole;
-                    if (debug)
-                    {
-                        std::cout << "[DEBUG] Graine " << colorToString(current_seed_color)
-                                  << " -> Trou " << current_hole << " (règle RED)" << std::endl;
-                    }
-                }
-                else if (distribution_rule == Color::BLUE)
-                {
-                    // Les bleus vont uniquement dans les trous adverses
-                    if (isOpponentHole(current_hole, player))
-                    {
-                        state->holes[current_hole][current_seed_color]++;
-                        last_hole_seeded = current_hole;
-                        if (debug)
-                        {
-                            std::cout << "[DEBUG] Graine " << colorToString(current_seed_color)
-                                      << " -> Trou adversaire " << current_hole << " (règle BLUE)" << std::endl;
-                        }
-                    }
-                    else
-                    {
-                        // Si ce n'est pas un trou adverse, on remet la graine et on continue
-                        if (current_seed_color == Color::TRANSPARENT)
-                        {
-                            trans_remaining++;
-                        }
-                        else
-                        {
-                            colored_remaining++;
-                        }
-                    }
-                }
-            }
+            std::cout << "\n[DEBUG] Joueur " << player << " joue trou " << hole << ", "
+                      << (transparent ? "TRANSPARENT comme " : "couleur ") << colorToString(distribution_rule) << std::endl;
+            std::cout << "[DEBUG] Graines à distribuer: "
+                      << (transparent ? seeds[2][src] : 0) + seeds[static_cast<int>(distribution_rule)][src] << std::endl;
         }
-        else
-        {
-            // Distribution normale pour RED ou BLUE seul
-            int seeds_to_distribute = state->holes[hole][color];
-            distribution_rule = color;
-            Color seed_color = color;
-            state->holes[hole][color] = 0;
 
-            int current_hole = hole;
-            int seeds_remaining = seeds_to_distribute;
+        alignas(16) uint8_t before[PLANE] = {};
+        if (debug)
+        {
+            planeTotals(seeds, before);
+        }
 
-            if (debug)
-            {
-                std::cout << "\n[DEBUG] Joueur " << player << " joue trou " << hole
-                          << ", couleur " << colorToString(seed_color) << std::endl;
-                std::cout << "[DEBUG] Distribution selon les règles: " << colorToString(distribution_rule) << std::endl;
-                std::cout << "[DEBUG] Graines à distribuer: " << seeds_to_distribute << std::endl;
-            }
+        int last = sow(seeds, src, static_cast<int>(distribution_rule), transparent);
 
-            while (seeds_remaining > 0)
+        if (debug)
+        {
+            alignas(16) uint8_t after[PLANE];
+            planeTotals(seeds, after);
+            for (int h = 1; h <= HOLES; h++)
             {
-                current_hole = nextHole(current_hole);
-
-                // Distribution selon les règles de distribution_rule
-                if (distribution_rule == Color::RED)
+                int added = after[h - 1] - before[h - 1];
+                if (added > 0)
                 {
-                    // Les rouges vont dans tous les trous
-                    state->holes[current_hole][seed_color]++;
-                    last_hole_seeded = current_hole;
-                    if (debug)
-                    {
-                        std::cout << "[DEBUG] Graine " << colorToString(seed_color)
-                                  << " -> Trou " << current_hole << " (règle RED)" << std::endl;
-                    }
-                    seeds_remaining--;
-                }
-                else if (distribution_rule == Color::BLUE)
-                {
-                    // Les bleus vont uniquement dans les trous adverses
-                    if (isOpponentHole(current_hole, player))
-                    {
-                        state->holes[current_hole][seed_color]++;
-                        last_hole_seeded = current_hole;
-                        if (debug)
-                        {
-                            std::cout << "[DEBUG] Graine " << colorToString(seed_color)
-                                      << " -> Trou adversaire " << current_hole << " (règle BLUE)" << std::endl;
-                        }
-                        seeds_remaining--;
-                    }
+                    std::cout << "[DEBUG] +" << added << " graine(s) -> Trou " << h
+                              << " (règle " << colorToString(distribution_rule) << ")" << std::endl;
                 }
             }
         }
 
         // Capture à partir du dernier trou semé (si une graine a été semée)
-        if (last_hole_seeded != -1)
+        if (last != -1)
         {
-            captureSeeds(last_hole_seeded, player);
+            captureSeeds(last + 1, player);
         }
 
+        // Résumé des camps (lu par l'évaluation)
+        updateFeatures(seeds, state->features);
+
         // Incrémenter le compteur de coups
         state->move_count++;
 
@@ -241,6 +479,26 @@ public:
         return true;
     }
 
+    template <int Player>
+    static void makeMove(State &state, Move move)
+    {
+        /**
+        Noyau de recherche: joue un coup produit par MoveGenerator::generate<Player>, sans
+        validation ni trace. Joueur au trait, camp capturant et joueur suivant sont des constantes
+        Même résultat que playMove pour un coup légal
+        */
+        static_assert(Player == 1 || Player == 2, "joueur 1 ou 2");
+        uint8_t(*seeds)[PLANE] = state.holes.seeds;
+        int last = sow(seeds, move.hole() - 1, move.type() & 1, move.useTransparent());
+        if (last != -1)
+        {
+            state.captured_seeds[Player] += capture(seeds, last);
+        }
+        updateFeatures(seeds, state.features);
+        state.move_count++;
+        state.current_player = 3 - Player;
+    }
+
 private:
     void captureSeeds(int last_hole, int player)
     {
@@ -259,58 +517,35 @@ private:
             std::cout << "[DEBUG] Vérification de capture en partant du trou " << last_hole << std::endl;
         }
 
-        int current_hole = last_hole;
-        int captured_total = 0;
-
-        // Remonte en arrière en sens anti-horaire depuis n'importe quel trou
-        while (true)
+        uint8_t(*seeds)[PLANE] = state->holes.seeds;
+        alignas(16) uint8_t totals[PLANE] = {};
+        if (debug)
         {
-            int total_seeds = state->getTotalSeeds(current_hole);
+            planeTotals(seeds, totals);
+        }
 
-            if (debug)
-            {
-                std::cout << "[DEBUG] Trou " << current_hole << ": " << total_seeds << " graines" << std::endl;
-            }
+        uint32_t captured_holes = 0;
+        int captured_total = capture(seeds, last_hole - 1, &captured_holes);
+        state->captured_seeds[player] += captured_total;
 
-            if (total_seeds == 2 || total_seeds == 3)
+        if (debug)
+        {
+            // Chaîne capturée, du dernier trou semé vers l'arrière
+            int current_hole = last_hole;
+            while (captured_holes & (1u << (current_hole - 1)))
             {
-                // Capture ce trou
-                int seeds_captured = total_seeds;
-                captured_total += seeds_captured;
-
-                if (debug)
-                {
-                    std::cout << "[DEBUG] ✓ Capture du trou " << current_hole
-                              << " (" << seeds_captured << " graines)" << std::endl;
-                }
-
-                // Réinitialise le trou
-                for (Color col : {Color::RED, Color::BLUE, Color::TRANSPARENT})
-                {
-                    state->holes[current_hole][col] = 0;
-                }
-
-                state->captured_seeds[player] += seeds_captured;
-
-                // Continue vers le trou précédent
+                std::cout << "[DEBUG] ✓ Capture du trou " << current_hole
+                          << " (" << static_cast<int>(totals[current_hole - 1]) << " graines)" << std::endl;
+                captured_holes &= ~(1u << (current_hole - 1));
                 current_hole = prevHole(current_hole);
             }
-            else
+            std::cout << "[DEBUG] ✗ Fin de capture - le trou " << current_hole
+                      << " n'a pas 2-3 graines (" << state->getTotalSeeds(current_hole) << ")" << std::endl;
+            if (captured_total > 0)
             {
-                // Arrête la capture
-                if (debug)
-                {
-                    std::cout << "[DEBUG] ✗ Fin de capture - le trou " << current_hole
-                              << " n'a pas 2-3 graines (" << total_seeds << ")" << std::endl;
-                }
-                break;
+                std::cout << "[DEBUG] Total capturé: " << captured_total << " graines" << std::endl;
             }
         }
-
-        if (debug && captured_total > 0)
-        {
-            std::cout << "[DEBUG] Total capturé: " << captured_total << " graines" << std::endl;
-        }
     }
 
 public:
@@ -321,53 +556,86 @@ public:
     }
 };
 
-class MoveGenerator
+using GameEngine = BasicGameEngine<StandardRules>;
+
+template <class Rules>
+class BasicMoveGenerator
 {
 public:
     /**Générateur de mouvements pour l'IA*/
+    using State = BasicGameState<Rules>;
+    using List = BasicMoveList<4 * Rules::HOLES_PER_PLAYER>;
 
-    static std::vector<std::tuple<int, Color, Color, bool>> getAllMoves(const GameState &state, int player)
+    static List getAllMoves(const State &state, int player)
     {
         /**
         Génère tous les coups possibles pour un joueur
         Inclut les graines RED, BLUE et TRANSPARENT (comme transparentRED et transparentBLUE)
+        Ordre: trous du joueur croissants, puis R, B, TR, TB
+        */
+        if (player == 1)
+        {
+            return generate<1>(state);
+        }
+        return generate<2>(state);
+    }
 
-        Retourne: (hole, color_to_play, transparent_as_color, use_transparent)
+    template <int Player>
+    static List generate(const State &state)
+    {
+        /**
+        getAllMoves pour un joueur fixé à la compilation: trous du joueur (impairs ou pairs)
+        en indices constants, boucle entièrement déroulée
         */
-        std::vector<std::tuple<int, Color, Color, bool>> moves;
+        static_assert(Player == 1 || Player == 2, "joueur 1 ou 2");
+        PROFILE_ZONE(PROFILE_MOVEGEN);
+        List moves;
 
-        for (int hole : state.getPlayerHoles(player))
+        const uint8_t(*seeds)[Rules::PLANE] = state.holes.seeds;
+        for (int i = 0; i < Rules::HOLES_PER_PLAYER; i++)
         {
-            // Générer les coups pour les couleurs ROUGE et BLEU
-            if (state.holes.at(hole).at(Color::RED) > 0)
+            const int idx = 2 * i + Player - 1;
+            uint8_t base = static_cast<uint8_t>(idx << 2);
+            if (seeds[0][idx] > 0)
             {
-                moves.push_back({hole, Color::RED, Color::RED, false});
+                moves.push_back(Move(base));
             }
-            if (state.holes.at(hole).at(Color::BLUE) > 0)
+            if (seeds[1][idx] > 0)
             {
-                moves.push_back({hole, Color::BLUE, Color::RED, false});
+                moves.push_back(Move(static_cast<uint8_t>(base | 1)));
             }
-            // Générer les coups pour TRANSPARENT (comme RED ou comme BLUE)
-            if (state.holes.at(hole).at(Color::TRANSPARENT) > 0)
+            // TRANSPARENT joué comme RED ou comme BLUE
+            if (seeds[2][idx] > 0)
             {
-                moves.push_back({hole, Color::TRANSPARENT, Color::RED, true});
-                moves.push_back({hole, Color::TRANSPARENT, Color::BLUE, true});
+                moves.push_back(Move(static_cast<uint8_t>(base | 2)));
+                moves.push_back(Move(static_cast<uint8_t>(base | 3)));
             }
         }
 
         return moves;
     }
 
-    static GameState applyMove(const GameState &state, int hole, Color color, Color transparent_as = Color::RED, bool use_transparent = false)
+    static State applyMove(const State &state, Move move)
     {
         /**
         Applique un coup à un état et retourne le nouvel état
         */
-        GameState new_state = state.copy();
-        GameEngine engine(&new_state);
-        engine.playMove(hole, color, transparent_as, use_transparent);
+        State new_state = state.copy();
+        BasicGameEngine<Rules> engine(&new_state);
+        engine.playMove(move);
+        return new_state;
+    }
+
+    template <int Player>
+    static State applyMove(const State &state, Move move)
+    {
+        /**applyMove pour un coup de generate<Player> (BasicGameEngine::makeMove, sans validation)*/
+        State new_state = state;
+        BasicGameEngine<Rules>::template makeMove<Player>(new_state, move);
         return new_state;
     }
 };
 
+using MoveGenerator = BasicMoveGenerator<StandardRules>;
+
 #endif // GAME_ENGINE_H
@@ -0,0 +1,380 @@
+/**
+ * Journal binaire des parties (ajout seul) et lecteur par projection mémoire (mmap)
+ *
+ * Fichier: en-tête de 8 octets ("MGLOG" + version + 2 octets réservés), puis une
+ * suite d'enregistrements, un par partie:
+ *     GameLogHeader (24 octets)
+ *     nom du joueur 1, nom du joueur 2 (sans '\0')
+ *     position de départ (PackedPosition, 32 octets) si LOG_FLAG_START
+ *     (LOG_FLAG_NO_START: départ non représentable, coups non rejouables)
+ *     codes des coups (1 octet par coup)
+ *     temps des coups (uint16, dixièmes de milliseconde, saturé à 65535)
+ *
+ * Un coup est son code Move sur un octet (move.h)
+ * Un enregistrement est écrit en un seul appel write() sur un fichier O_APPEND, et un
+ * fichier n'apparaît qu'avec son en-tête (GameLogWriter::create): plusieurs threads
+ * (ou processus) peuvent journaliser dans le même fichier.
+ */
+
+#ifndef GAME_LOG_H
+#define GAME_LOG_H
+
+#include "game_rules.h"
+#include "move.h"
+#include "notation.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char GAME_LOG_MAGIC[6] = {'M', 'G', 'L', 'O', 'G', 1}; // magic + version
+
+enum GameLogFlags : uint8_t
+{
+    LOG_FLAG_START = 1,   // position de départ présente (partie issue d'une ouverture)
+    LOG_FLAG_NO_START = 2 // position de départ hors de la position initiale mais non représentable
+};
+
+enum class GameLogEnd : uint8_t
+{
+    NORMAL = 0,  // fin selon les règles
+    TIMEOUT = 1, // un joueur a dépassé le temps
+    ABORTED = 2  // coup invalide, plus de coup, arrêt du protocole
+};
+
+#pragma pack(push, 1)
+struct GameLogHeader
+{
+    uint32_t size;       // taille totale de l'enregistrement (en-tête compris)
+    uint32_t timestamp;  // secondes Unix
+    uint16_t move_count; // nombre de coups enregistrés
+    uint8_t winner;      // 1, 2 ou 0 (égalité)
+    uint8_t end;         // GameLogEnd
+    uint8_t captured[2]; // graines capturées (J1, J2)
+    uint8_t name_length[2];
+    uint8_t flags;       // GameLogFlags
+    uint8_t reserved[7];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(GameLogHeader) == 24, "GameLogHeader: 24 octets");
+
+struct GameLogRecord
+{
+    /**Partie en cours de construction (côté écriture)*/
+    std::string player1;
+    std::string player2;
+    bool has_start = false;
+    bool start_lost = false; // départ non représentable (LOG_FLAG_NO_START)
+    PackedPosition start{};
+    std::vector<uint8_t> moves;
+    std::vector<uint16_t> times;
+    int winner = 0;
+    int captured1 = 0;
+    int captured2 = 0;
+    GameLogEnd end = GameLogEnd::NORMAL;
+
+    GameLogRecord()
+    {
+        moves.reserve(GameState::MAX_MOVES);
+        times.reserve(GameState::MAX_MOVES);
+    }
+
+    bool setStart(const GameState &state)
+    {
+        /**
+        Enregistre la position de départ si ce n'est pas la position initiale
+        false si elle n'est pas représentable (Notation::pack): la partie est marquée non rejouable
+        */
+        bool initial = state == GameState();
+        has_start = !initial && Notation::pack(state, start);
+        start_lost = !initial && !has_start;
+        return !start_lost;
+    }
+
+    void addMove(Move move, double seconds)
+    {
+        double tenths_ms = seconds * 10000.0;
+        moves.push_back(move.code);
+        times.push_back(static_cast<uint16_t>(tenths_ms < 65535.0 ? tenths_ms : 65535.0));
+    }
+
+    void setResult(const GameState &state, GameLogEnd reason = GameLogEnd::NORMAL)
+    {
+        winner = state.getWinner();
+        captured1 = state.captured_seeds[1];
+        captured2 = state.captured_seeds[2];
+        end = reason;
+    }
+};
+
+class GameLogWriter
+{
+public:
+    /**Écriture en ajout seul, un enregistrement par write()*/
+    GameLogWriter() = default;
+    explicit GameLogWriter(const std::string &path) { open(path); }
+    ~GameLogWriter() { close(); }
+
+    GameLogWriter(const GameLogWriter &) = delete;
+    GameLogWriter &operator=(const GameLogWriter &) = delete;
+
+    bool open(const std::string &path)
+    {
+        /**Ouvre en ajout; un fichier absent est d'abord créé avec son en-tête*/
+        close();
+        fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+        if (fd < 0 && errno == ENOENT && create(path))
+        {
+            fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+        }
+        return fd >= 0;
+    }
+
+    static bool create(const std::string &path)
+    {
+        /**
+        Crée path avec l'en-tête sans fenêtre où il serait vide: en-tête écrit dans un fichier
+        temporaire du même répertoire, publié par link() (EEXIST: un autre processus l'a créé)
+        Système de fichiers sans liens: O_EXCL, seul le créateur écrit l'en-tête
+        */
+        char file_header[8] = {};
+        std::memcpy(file_header, GAME_LOG_MAGIC, sizeof(GAME_LOG_MAGIC));
+
+        std::string temp = path + ".XXXXXX";
+        int temp_fd = mkstemp(&temp[0]);
+        if (temp_fd >= 0)
+        {
+            bool written = fchmod(temp_fd, 0644) == 0 &&
+                           ::write(temp_fd, file_header, sizeof(file_header)) == sizeof(file_header);
+            ::close(temp_fd);
+            int linked = written ? link(temp.c_str(), path.c_str()) : -1;
+            int link_error = errno;
+            unlink(temp.c_str());
+            if (linked == 0 || (written && link_error == EEXIST))
+            {
+                return true;
+            }
+            if (!written || (link_error != EPERM && link_error != ENOTSUP))
+            {
+                return false;
+            }
+        }
+
+        int new_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (new_fd < 0)
+        {
+            return errno == EEXIST;
+        }
+        bool written = ::write(new_fd, file_header, sizeof(file_header)) == sizeof(file_header);
+        ::close(new_fd);
+        return written;
+    }
+
+    bool isOpen() const { return fd >= 0; }
+
+    void close()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    bool append(const GameLogRecord &record)
+    {
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        size_t name1 = std::min<size_t>(record.player1.size(), 255);
+        size_t name2 = std::min<size_t>(record.player2.size(), 255);
+        size_t moves = std::min<size_t>(record.moves.size(), 65535);
+        size_t size = sizeof(GameLogHeader) + name1 + name2 + (record.has_start ? sizeof(PackedPosition) : 0) +
+                      moves * (1 + sizeof(uint16_t));
+
+        GameLogHeader header{};
+        header.size = static_cast<uint32_t>(size);
+        header.timestamp = static_cast<uint32_t>(std::time(nullptr));
+        header.move_count = static_cast<uint16_t>(moves);
+        header.winner = static_cast<uint8_t>(record.winner);
+        header.end = static_cast<uint8_t>(record.end);
+        header.captured[0] = static_cast<uint8_t>(record.captured1);
+        header.captured[1] = static_cast<uint8_t>(record.captured2);
+        header.name_length[0] = static_cast<uint8_t>(name1);
+        header.name_length[1] = static_cast<uint8_t>(name2);
+        header.flags = record.has_start ? LOG_FLAG_START : (record.start_lost ? LOG_FLAG_NO_START : 0);
+
+        std::vector<uint8_t> buffer(size);
+        uint8_t *p = buffer.data();
+        std::memcpy(p, &header, sizeof(header));
+        p += sizeof(header);
+        std::memcpy(p, record.player1.data(), name1);
+        p += name1;
+        std::memcpy(p, record.player2.data(), name2);
+        p += name2;
+        if (record.has_start)
+        {
+            std::memcpy(p, record.start.bytes, sizeof(PackedPosition));
+            p += sizeof(PackedPosition);
+        }
+        std::memcpy(p, record.moves.data(), moves);
+        p += moves;
+        std::memcpy(p, record.times.data(), moves * sizeof(uint16_t));
+
+        std::lock_guard<std::mutex> lock(mutex);
+        return ::write(fd, buffer.data(), size) == static_cast<ssize_t>(size);
+    }
+
+private:
+    int fd = -1;
+    std::mutex mutex;
+};
+
+struct GameLogView
+{
+    /**Partie lue directement dans le fichier projeté (aucune copie)*/
+    const GameLogHeader *header;
+    const char *player1;
+    const char *player2;
+    const uint8_t *start; // PackedPosition, ou nullptr
+    const uint8_t *moves;
+    const uint8_t *times; // uint16 petit-boutistes, non alignés
+
+    int moveCount() const { return header->move_count; }
+    Move move(int i) const { return Move(moves[i]); }
+    std::string player1Name() const { return std::string(player1, header->name_length[0]); }
+    std::string player2Name() const { return std::string(player2, header->name_length[1]); }
+
+    double moveSeconds(int i) const
+    {
+        uint16_t tenths_ms;
+        std::memcpy(&tenths_ms, times + 2 * i, sizeof(tenths_ms));
+        return tenths_ms / 10000.0;
+    }
+
+    bool replayable() const { return !(header->flags & LOG_FLAG_NO_START); }
+
+    bool startPosition(GameState &state) const
+    {
+        /**Position de départ de la partie (position initiale si absente); false si non rejouable*/
+        if (!replayable())
+        {
+            return false;
+        }
+        if (!start)
+        {
+            state = GameState();
+            return true;
+        }
+        PackedPosition packed;
+        std::memcpy(packed.bytes, start, sizeof(packed.bytes));
+        return Notation::unpack(packed, state);
+    }
+};
+
+class GameLogReader
+{
+public:
+    /**Lecteur par mmap: parcourt les enregistrements sans analyse de texte ni copie*/
+    GameLogReader() = default;
+    explicit GameLogReader(const std::string &path) { open(path); }
+    ~GameLogReader() { close(); }
+
+    GameLogReader(const GameLogReader &) = delete;
+    GameLogReader &operator=(const GameLogReader &) = delete;
+
+    bool open(const std::string &path)
+    {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < 8)
+        {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(st.st_size);
+        void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED)
+        {
+            size = 0;
+            return false;
+        }
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        data = static_cast<const uint8_t *>(mapped);
+        if (std::memcmp(data, GAME_LOG_MAGIC, sizeof(GAME_LOG_MAGIC)) != 0)
+        {
+            close();
+            return false;
+        }
+        offset = 8;
+        return true;
+    }
+
+    void close()
+    {
+        if (data)
+        {
+            munmap(const_cast<uint8_t *>(data), size);
+            data = nullptr;
+        }
+        size = 0;
+        offset = 0;
+    }
+
+    void rewind() { offset = 8; }
+
+    bool next(GameLogView &view)
+    {
+        /**Partie suivante; false à la fin du fichier ou sur un enregistrement tronqué*/
+        if (!data || offset + sizeof(GameLogHeader) > size)
+        {
+            return false;
+        }
+        const GameLogHeader *header = reinterpret_cast<const GameLogHeader *>(data + offset);
+        size_t names = header->name_length[0] + header->name_length[1];
+        size_t start = (header->flags & LOG_FLAG_START) ? sizeof(PackedPosition) : 0;
+        size_t expected = sizeof(GameLogHeader) + names + start + header->move_count * (1 + sizeof(uint16_t));
+        if (header->size != expected || offset + expected > size)
+        {
+            return false;
+        }
+
+        const uint8_t *p = data + offset + sizeof(GameLogHeader);
+        view.header = header;
+        view.player1 = reinterpret_cast<const char *>(p);
+        view.player2 = view.player1 + header->name_length[0];
+        p += names;
+        view.start = start ? p : nullptr;
+        p += start;
+        view.moves = p;
+        view.times = p + header->move_count;
+        offset += expected;
+        return true;
+    }
+
+private:
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+};
+
+#endif // GAME_LOG_H
@@ -9,6 +9,7 @@
 #include "game_engine.h"
 #include "ai_algorithms.h"
 #include "config.h"
+#include "game_log.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -45,6 +46,7 @@ public:
     std::unique_ptr<MinMaxBot> minmax_bot;
     std::unique_ptr<AlphaBetaBot> alphabeta_bot;
     std::unique_ptr<IterativeDeepeningDFSBot> iddfs_bot;
+    std::unique_ptr<MCTSBot> mcts_bot;
 
     AIPlayer(int id, const std::string& algo_name, int d = 3) 
         : algorithm_name(algo_name), depth(d) {
@@ -69,6 +71,8 @@ public:
             alphabeta_bot = std::make_unique<AlphaBetaBot>(d);
         } else if (lower_name == "iddfs") {
             iddfs_bot = std::make_unique<IterativeDeepeningDFSBot>(d);
+        } else if (lower_name == "mcts") {
+            mcts_bot = std::make_unique<MCTSBot>();
         }
     }
 
@@ -87,6 +91,8 @@ public:
             return alphabeta_bot->getMove(state, player_id);
         } else if (lower_name == "iddfs" && iddfs_bot) {
             return iddfs_bot->getMove(state, player_id);
+        } else if (lower_name == "mcts" && mcts_bot) {
+            return mcts_bot->getMove(state, player_id);
         }
         return Move();
     }
@@ -103,7 +109,7 @@ public:
 
     bool isHuman() const override { return true; }
 
-    std::optional<std::tuple<int, Color, Color, bool>> parseMoveInput(const std::string& move_str, const GameState& state) {
+    Move parseMoveInput(const std::string& move_str, const GameState& state) {
         /**
         Parse l'entrée utilisateur au format simple
         Formats acceptés:
@@ -111,50 +117,14 @@ public:
         - "3R" : Trou 3, couleur ROUGE
         - "5TR" : Trou 5, graines TRANSPARENTES comme ROUGE
         - "8TB" : Trou 8, graines TRANSPARENTES comme BLEU
+        Retourne Move() si le format est invalide
         */
-        std::string upper_str = move_str;
-        // Trim whitespace
-        upper_str.erase(0, upper_str.find_first_not_of(" \t\n\r"));
-        upper_str.erase(upper_str.find_last_not_of(" \t\n\r") + 1);
-        // Convert to uppercase
-        std::transform(upper_str.begin(), upper_str.end(), upper_str.begin(), ::toupper);
-
-        // Parser le format: numero + couleur(s)
-        if (upper_str.length() >= 3 && upper_str.substr(upper_str.length() - 2) == "TR") {
-            // Transparent comme Rouge
-            try {
-                int hole = std::stoi(upper_str.substr(0, upper_str.length() - 2));
-                return std::make_tuple(hole, Color::TRANSPARENT, Color::RED, true);
-            } catch (...) {
-                return std::nullopt;
-            }
-        } else if (upper_str.length() >= 3 && upper_str.substr(upper_str.length() - 2) == "TB") {
-            // Transparent comme Bleu
-            try {
-                int hole = std::stoi(upper_str.substr(0, upper_str.length() - 2));
-                return std::make_tuple(hole, Color::TRANSPARENT, Color::BLUE, true);
-            } catch (...) {
-                return std::nullopt;
-            }
-        } else if (upper_str.length() >= 2 && upper_str.back() == 'R') {
-            // Rouge
-            try {
-                int hole = std::stoi(upper_str.substr(0, upper_str.length() - 1));
-                return std::make_tuple(hole, Color::RED, Color::RED, false);
-            } catch (...) {
-                return std::nullopt;
-            }
-        } else if (upper_str.length() >= 2 && upper_str.back() == 'B') {
-            // Bleu
-            try {
-                int hole = std::stoi(upper_str.substr(0, upper_str.length() - 1));
-                return std::make_tuple(hole, Color::BLUE, Color::BLUE, false);
-            } catch (...) {
-                return std::nullopt;
-            }
+        size_t begin = move_str.find_first_not_of(" \t\n\r");
+        if (begin == std::string::npos) {
+            return Move();
         }
-
-        return std::nullopt;
+        size_t end = move_str.find_last_not_of(" \t\n\r") + 1;
+        return Move::parse(move_str.data() + begin, end - begin);
     }
 
     bool isMoveValid(int hole, Color color, const GameState& state) {
@@ -206,24 +176,22 @@ public:
                 std::getline(std::cin, move_input);
 
                 // Parser l'entrée
-                auto parsed = parseMoveInput(move_input, state);
+                Move parsed = parseMoveInput(move_input, state);
 
-                if (!parsed.has_value()) {
+                if (!parsed.valid()) {
                     // std::cout << "Format invalide! Utilisez le format: [TROU][COULEUR]" << std::endl;
                     // std::cout << "Exemples: 14B, 3R, 5TR, 8TB" << std::endl;
                     continue;
                 }
 
-                auto [hole, color, trans_as, use_trans] = parsed.value();
-
                 // Vérifier la validité du coup
-                if (!isMoveValid(hole, color, state)) {
+                if (!isMoveValid(parsed.hole(), parsed.color(), state)) {
                     // std::cout << "Coup invalide! Le trou " << hole << " n'a pas de graines " 
                     //           << colorToString(color) << std::endl;
                     continue;
                 }
 
-                return Move(hole, color, trans_as, use_trans);
+                return parsed;
 
             } catch (...) {
                 // std::cout << "Erreur! Veuillez réessayer!" << std::endl;
@@ -261,16 +229,20 @@ public:
     std::map<int, std::unique_ptr<Player>> players;
     std::vector<MoveRecord> move_history;
     int total_moves;
+    GameLogWriter* game_log = nullptr; // journal binaire des parties (optionnel)
+    GameLogRecord log_record;
 
     GameManager(const std::string& player1_type, const std::map<std::string, int>& player1_config,
                 const std::string& player2_type, const std::map<std::string, int>& player2_config)
         : engine(&state), total_moves(0) {
         /**
-        player_type: "human" ou nom de l'algorithme ("bfs", "dfs", "minimax", "iddfs")
+        player_type: "human" ou nom de l'algorithme ("bfs", "dfs", "minimax", "iddfs", "mcts")
         player_config: map avec "depth" pour les IA
         */
         createPlayer(1, player1_type, player1_config);
         createPlayer(2, player2_type, player2_config);
+        log_record.player1 = player1_type;
+        log_record.player2 = player2_type;
     }
 
     void createPlayer(int player_id, const std::string& player_type, const std::map<std::string, int>& config) {
@@ -330,32 +302,29 @@ public:
             return false;
         }
 
-        if (!move.valid) {
+        if (!move.valid()) {
             // std::cout << "Aucun coup valide pour le joueur " << player_id << std::endl;
             return false;
         }
 
-        if (!engine.playMove(move.hole, move.color, move.transparent_as, move.use_transparent)) {
-            // std::cout << "Coup invalide: " << move.hole << colorToString(move.color) << std::endl;
+        if (!engine.playMove(move)) {
+            // std::cout << "Coup invalide: " << move.text() << std::endl;
             return false;
         }
 
         move_history.push_back({
             player_id,
-            move.hole,
-            colorToString(move.color),
-            move.use_transparent ? colorToString(move.transparent_as) : "",
+            move.hole(),
+            colorToString(move.color()),
+            move.useTransparent() ? colorToString(move.transparentAs()) : "",
             elapsed,
             false
         });
+        log_record.addMove(move, elapsed);
         total_moves++;
 
         if (verbose) {
-            if (move.use_transparent) {
-                std::cout << move.hole << "T" << colorToString(move.transparent_as) << std::endl;
-            } else {
-                std::cout << move.hole << colorToString(move.color) << std::endl;
-            }
+            std::cout << move.text() << std::endl;
             // std::cout << "   Temps de calcul: " << elapsed << "s" << std::endl;
         }
 
@@ -441,6 +410,9 @@ public:
         Retourne l'ID du gagnant (0 pour égalité)
         */
         int turn_count = 0;
+        if (!log_record.setStart(state) && game_log) {
+            std::cerr << "Journal: position de départ non représentable, partie marquée non rejouable" << std::endl;
+        }
 
         while (!state.isGameOver() && turn_count < max_turns) {
             if (!playTurn(verbose)) {
@@ -449,6 +421,13 @@ public:
             turn_count++;
         }
 
+        if (game_log) {
+            bool timeout = !move_history.empty() && move_history.back().timeout;
+            log_record.setResult(state, timeout ? GameLogEnd::TIMEOUT
+                                                : (state.isGameOver() ? GameLogEnd::NORMAL : GameLogEnd::ABORTED));
+            game_log->append(log_record);
+        }
+
         // if (verbose) {
         //     std::cout << "\n" << std::string(80, '=') << std::endl;
         //     std::cout << "FIN DE LA PARTIE" << std::endl;
@@ -500,52 +479,4 @@ public:
 };
 
 
-class Tournament {
-public:
-    /**Gère un tournoi entre plusieurs IA*/
-    std::vector<std::map<std::string, std::string>> results;
-
-    void playMatch(const std::string& player1_type, const std::map<std::string, int>& player1_config,
-                   const std::string& player2_type, const std::map<std::string, int>& player2_config,
-                   bool verbose = false) {
-        /**Joue un match entre deux joueurs*/
-        GameManager manager(player1_type, player1_config, player2_type, player2_config);
-        int winner = manager.playGame(verbose);
-
-        GameStats stats = manager.getGameStats();
-        
-        std::map<std::string, std::string> match_result;
-        match_result["player1"] = player1_type;
-        match_result["player2"] = player2_type;
-        match_result["winner"] = std::to_string(winner);
-        match_result["player1_captured"] = std::to_string(stats.player1_captured);
-        match_result["player2_captured"] = std::to_string(stats.player2_captured);
-
-        results.push_back(match_result);
-    }
-
-    void printResults() {
-        /**Affiche les résultats du tournoi*/
-        // std::cout << "\n" << std::string(80, '=') << std::endl;
-        // std::cout << "RÉSULTATS DU TOURNOI" << std::endl;
-        // std::cout << std::string(80, '=') << std::endl;
-
-        // int i = 1;
-        // for (const auto& result : results) {
-        //     std::cout << "\nMatch " << i++ << ":" << std::endl;
-        //     std::cout << "  " << result.at("player1") << " vs " << result.at("player2") << std::endl;
-
-        //     if (result.at("winner") == "0") {
-        //         std::cout << "  Résultat: ÉGALITÉ" << std::endl;
-        //     } else {
-        //         std::string winner_name = result.at("winner") == "1" ? result.at("player1") : result.at("player2");
-        //         std::cout << "  Gagnant: Joueur " << result.at("winner") << " (" << winner_name << ")" << std::endl;
-        //     }
-
-        //     std::cout << "  Graines capturées - J1: " << result.at("player1_captured") 
-        //               << ", J2: " << result.at("player2_captured") << std::endl;
-        // }
-    }
-};
-
 #endif // GAME_MANAGER_H
@@ -6,16 +6,58 @@
  * - Joueur 2: trous pairs (2,4,6,8,10,12,14,16)
  * - Au départ: 2 graines rouges, 2 bleues, 2 transparentes par trou
  * - Trois couleurs: Red (R), Blue (B), Transparent (T)
+ *
+ * Variantes: plateau, graines et seuils sont les paramètres constexpr d'un RuleSet.
+ * BasicGameState<Rules> (et le moteur de game_engine.h) est instancié par variante;
+ * GameState est celui des règles standard (config.h).
  */
 
 #ifndef GAME_RULES_H
 #define GAME_RULES_H
 
-#include <map>
+#include "config.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <string>
 #include <sstream>
 
+template <int Holes, int SeedsPerColor, int CaptureMin, int CaptureMax,
+          int WinningSeeds, int DrawThreshold, int GameEndSeeds, int MaxMoves>
+struct RuleSet
+{
+    /**
+    Descripteur d'une variante des règles, entièrement connu à la compilation
+    Joueur 1: trous impairs, joueur 2: trous pairs, quel que soit le nombre de trous
+    */
+    static constexpr int HOLES = Holes;
+    static constexpr int HOLES_PER_PLAYER = Holes / 2;
+    static constexpr int SEEDS_PER_COLOR = SeedsPerColor;
+    static constexpr int TOTAL_SEEDS = 3 * Holes * SeedsPerColor;
+    static constexpr int CAPTURE_MIN = CaptureMin;
+    static constexpr int CAPTURE_MAX = CaptureMax;
+    static constexpr int WINNING_SEEDS = WinningSeeds;
+    static constexpr int DRAW_THRESHOLD = DrawThreshold;
+    static constexpr int GAME_END_SEEDS = GameEndSeeds;
+    static constexpr int MAX_MOVES = MaxMoves;
+
+    // Octets par couleur: des vecteurs de 16 entiers, trous au-delà de HOLES toujours vides
+    static constexpr int PLANE = (Holes + 15) / 16 * 16;
+    static constexpr uint32_t HOLE_MASK = (1u << Holes) - 1;
+
+    static_assert(Holes % 2 == 0 && Holes >= 4 && Holes <= 30, "trous: nombre pair de 4 à 30 (masques 32 bits)");
+    static_assert(SeedsPerColor >= 1 && TOTAL_SEEDS <= 255, "compteurs et sommes par camp sur un octet");
+    static_assert(CaptureMin >= 1 && CaptureMin <= CaptureMax, "capture de CAPTURE_MIN à CAPTURE_MAX graines");
+};
+
+using StandardRules = RuleSet<TOTAL_HOLES, INITIAL_SEEDS_PER_COLOR, CAPTURE_MIN, CAPTURE_MAX,
+                              WINNING_SEEDS, DRAW_THRESHOLD, GAME_END_SEEDS, MAX_GAME_MOVES>;
+
+static_assert(StandardRules::HOLES_PER_PLAYER == HOLES_PER_PLAYER &&
+                  StandardRules::TOTAL_SEEDS == TOTAL_INITIAL_SEEDS,
+              "config.h: règles incohérentes");
+
 enum class Color
 {
     RED,
@@ -37,43 +79,142 @@ inline std::string colorToString(Color c)
     return "";
 }
 
-// Pre-computed player holes for speed
-const int PLAYER1_HOLES[8] = {1, 3, 5, 7, 9, 11, 13, 15};
-const int PLAYER2_HOLES[8] = {2, 4, 6, 8, 10, 12, 14, 16};
+template <int HolesPerPlayer>
+constexpr std::array<int, HolesPerPlayer> playerHoleList(int player)
+{
+    /**Trous du joueur, croissants: 1, 3, 5... (joueur 1) ou 2, 4, 6... (joueur 2)*/
+    std::array<int, HolesPerPlayer> holes{};
+    for (int i = 0; i < HolesPerPlayer; i++)
+    {
+        holes[i] = 2 * i + player;
+    }
+    return holes;
+}
 
-class GameState
+template <class Rules>
+class BasicHoleTable
 {
 public:
-    static const int MAX_MOVES = 400; // Limite de 400 coups (200 par joueur)
+    /**
+    Plateau compact: un octet par (couleur, trou), rangé par couleur
+    seeds[couleur][trou - 1] - aucune allocation, copie en un memcpy
+    Chaque couleur est un vecteur aligné de Rules::PLANE octets (les compteurs ne dépassent
+    jamais Rules::TOTAL_SEEDS)
+    L'accès holes[trou][couleur] / holes.at(trou).at(couleur) reste celui de l'ancien dictionnaire
+    */
+    static constexpr int PLANE = Rules::PLANE;
+
+    alignas(16) uint8_t seeds[3][PLANE];
+
+    class Hole
+    {
+    public:
+        Hole(uint8_t (*s)[PLANE], int i) : planes(s), index(i) {}
 
-    // Dictionnaire des trous: {numéro: {couleur: nombre}}
-    std::map<int, std::map<Color, int>> holes;
-    std::map<int, int> captured_seeds; // Graines capturées par joueur
+        uint8_t &operator[](Color c) { return planes[static_cast<int>(c)][index]; }
+        int at(Color c) const { return planes[static_cast<int>(c)][index]; }
+
+        Hole &operator=(const Hole &other)
+        {
+            // Copie les compteurs (et non la référence)
+            for (int c = 0; c < 3; c++)
+            {
+                planes[c][index] = other.planes[c][other.index];
+            }
+            return *this;
+        }
+
+    private:
+        uint8_t (*planes)[PLANE];
+        int index;
+    };
+
+    class ConstHole
+    {
+    public:
+        ConstHole(const uint8_t (*s)[PLANE], int i) : planes(s), index(i) {}
+
+        int operator[](Color c) const { return planes[static_cast<int>(c)][index]; }
+        int at(Color c) const { return planes[static_cast<int>(c)][index]; }
+
+    private:
+        const uint8_t (*planes)[PLANE];
+        int index;
+    };
+
+    Hole operator[](int hole) { return Hole(seeds, hole - 1); }
+    Hole at(int hole) { return Hole(seeds, hole - 1); }
+    ConstHole operator[](int hole) const { return ConstHole(seeds, hole - 1); }
+    ConstHole at(int hole) const { return ConstHole(seeds, hole - 1); }
+
+    bool operator==(const BasicHoleTable &other) const
+    {
+        return std::memcmp(seeds, other.seeds, sizeof(seeds)) == 0;
+    }
+};
+
+using HoleTable = BasicHoleTable<StandardRules>;
+
+struct BoardFeatures
+{
+    /**
+    Résumé des deux camps ([0]: J1, trous impairs; [1]: J2, trous pairs), tenu à jour à
+    chaque coup par le moteur (planeBoardFeatures dans game_engine.h): l'évaluation le lit
+    sans parcourir le plateau. Rangé par caractéristique, dans l'ordre des sommes vectorielles.
+    */
+    uint8_t seeds[2];             // graines dans ses trous
+    uint8_t transparent[2];       // graines transparentes dans ses trous
+    uint8_t mobility[2];          // coups légaux (R, B, TR, TB)
+    uint8_t vulnerable[2];        // trous à 1-2 graines (capturables au prochain semis)
+    uint8_t empty[2];             // trous vides
+    uint8_t transparent_holes[2]; // trous contenant des transparentes (sources de TR/TB)
+};
+
+template <class Rules>
+class BasicGameState
+{
+public:
+    using RulesType = Rules;
+    static constexpr int MAX_MOVES = Rules::MAX_MOVES; // Limite de coups (400 en standard, 200 par joueur)
+    static constexpr int HOLES = Rules::HOLES;
+    static constexpr int HOLES_PER_PLAYER = Rules::HOLES_PER_PLAYER;
+
+    // Pre-computed player holes for speed
+    static constexpr std::array<int, HOLES_PER_PLAYER> PLAYER1_HOLES = playerHoleList<HOLES_PER_PLAYER>(1);
+    static constexpr std::array<int, HOLES_PER_PLAYER> PLAYER2_HOLES = playerHoleList<HOLES_PER_PLAYER>(2);
+
+    BasicHoleTable<Rules> holes;       // holes[trou][couleur] = nombre de graines
+    std::array<int, 3> captured_seeds; // Graines capturées par joueur (indices 1 et 2)
     int current_player;
     int move_count; // Compteur de coups joués
+    BoardFeatures features; // Résumé des camps, dérivé de holes: [joueur - 1]
 
-    GameState() : current_player(1), move_count(0)
+    BasicGameState() : captured_seeds{0, 0, 0}, current_player(1), move_count(0)
     {
-        captured_seeds[1] = 0;
-        captured_seeds[2] = 0;
         initializeBoard();
     }
 
     void initializeBoard()
     {
-        /**Initialise le plateau avec 2 graines de chaque couleur par trou*/
-        for (int hole = 1; hole <= 16; hole++)
+        /**Initialise le plateau avec SEEDS_PER_COLOR graines de chaque couleur par trou (2 en standard)*/
+        std::memset(holes.seeds, 0, sizeof(holes.seeds));
+        for (int c = 0; c < 3; c++)
         {
-            holes[hole][Color::RED] = 2;
-            holes[hole][Color::BLUE] = 2;
-            holes[hole][Color::TRANSPARENT] = 2;
+            std::memset(holes.seeds[c], Rules::SEEDS_PER_COLOR, HOLES);
         }
+        // Chaque camp: HOLES_PER_PLAYER trous pleins, 4 coups jouables par trou
+        constexpr uint8_t side = HOLES_PER_PLAYER;
+        constexpr uint8_t seeds = 3 * Rules::SEEDS_PER_COLOR * HOLES_PER_PLAYER;
+        constexpr uint8_t transparent = Rules::SEEDS_PER_COLOR * HOLES_PER_PLAYER;
+        constexpr uint8_t vulnerable = 3 * Rules::SEEDS_PER_COLOR <= 2 ? side : 0;
+        features = BoardFeatures{{seeds, seeds}, {transparent, transparent}, {4 * side, 4 * side},
+                                 {vulnerable, vulnerable}, {0, 0}, {side, side}};
     }
 
     const int *getPlayerHolesPtr(int player) const
     {
         /**Retourne pointeur vers les trous du joueur (pour performance)*/
-        return (player == 1) ? PLAYER1_HOLES : PLAYER2_HOLES;
+        return (player == 1) ? PLAYER1_HOLES.data() : PLAYER2_HOLES.data();
     }
 
     std::vector<int> getPlayerHoles(int player) const
@@ -82,30 +223,30 @@ public:
         Joueur 1: trous impairs, Joueur 2: trous pairs*/
         if (player == 1)
         {
-            return std::vector<int>(PLAYER1_HOLES, PLAYER1_HOLES + 8);
+            return std::vector<int>(PLAYER1_HOLES.begin(), PLAYER1_HOLES.end());
         }
         else
         {
-            return std::vector<int>(PLAYER2_HOLES, PLAYER2_HOLES + 8);
+            return std::vector<int>(PLAYER2_HOLES.begin(), PLAYER2_HOLES.end());
         }
     }
 
     int getTotalSeeds(int hole) const
     {
         /**Retourne le nombre total de graines dans un trou - Optimized*/
-        const auto &h = holes.at(hole);
-        return h.at(Color::RED) + h.at(Color::BLUE) + h.at(Color::TRANSPARENT);
+        int i = hole - 1;
+        return holes.seeds[0][i] + holes.seeds[1][i] + holes.seeds[2][i];
     }
 
     int getSeedsOnBoard() const
     {
         /**Retourne le nombre total de graines sur le plateau*/
         int total = 0;
-        for (const auto &hole : holes)
+        for (int c = 0; c < 3; c++)
         {
-            for (const auto &color : hole.second)
+            for (int i = 0; i < HOLES; i++)
             {
-                total += color.second;
+                total += holes.seeds[c][i];
             }
         }
         return total;
@@ -117,28 +258,28 @@ public:
         Vérifie si le jeu est terminé selon les règles - Optimized
         */
         // Condition 0: Limite de 400 coups atteinte
-        if (move_count >= 400)
+        if (move_count >= MAX_MOVES)
         {
             return true;
         }
 
-        int c1 = captured_seeds.at(1);
-        int c2 = captured_seeds.at(2);
+        int c1 = captured_seeds[1];
+        int c2 = captured_seeds[2];
 
         // Condition 2: Un joueur a capturé 49+ graines (victoire)
-        if (c1 >= 49 || c2 >= 49)
+        if (c1 >= Rules::WINNING_SEEDS || c2 >= Rules::WINNING_SEEDS)
         {
             return true;
         }
 
         // Condition 3: Les deux joueurs ont capturé 40+ graines (égalité)
-        if (c1 >= 40 && c2 >= 40)
+        if (c1 >= Rules::DRAW_THRESHOLD && c2 >= Rules::DRAW_THRESHOLD)
         {
             return true;
         }
 
         // Condition 1: Moins de 10 graines sur le plateau (fast calc)
-        if (96 - c1 - c2 < 10)
+        if (Rules::TOTAL_SEEDS - c1 - c2 < Rules::GAME_END_SEEDS)
         {
             return true;
         }
@@ -157,11 +298,11 @@ public:
         - Sinon: celui avec le plus de graines gagne
         */
         // Si un joueur a 49+, il gagne
-        if (captured_seeds.at(1) >= 49)
+        if (captured_seeds.at(1) >= Rules::WINNING_SEEDS)
         {
             return 1;
         }
-        if (captured_seeds.at(2) >= 49)
+        if (captured_seeds.at(2) >= Rules::WINNING_SEEDS)
         {
             return 2;
         }
@@ -202,18 +343,22 @@ public:
         return valid_moves;
     }
 
-    GameState copy() const
+    BasicGameState copy() const
     {
-        /**Crée une copie de l'état du jeu*/
-        GameState new_state;
-        for (int hole = 1; hole <= 16; hole++)
-        {
-            new_state.holes[hole] = holes.at(hole);
-        }
-        new_state.captured_seeds = captured_seeds;
-        new_state.current_player = current_player;
-        new_state.move_count = move_count;
-        return new_state;
+        /**Crée une copie de l'état du jeu (état à plat: simple copie mémoire)*/
+        return *this;
+    }
+
+    bool operator==(const BasicGameState &other) const
+    {
+        /**Deux états sont identiques si plateau, scores, joueur et compteur coïncident*/
+        return current_player == other.current_player && move_count == other.move_count &&
+               captured_seeds == other.captured_seeds && holes == other.holes;
+    }
+
+    bool operator!=(const BasicGameState &other) const
+    {
+        return !(*this == other);
     }
 
     std::string toString() const
@@ -227,15 +372,20 @@ public:
         result << "Current player: " << current_player << "\n";
         result << std::string(80, '=') << "\n";
 
-        // Affichage du plateau
-        result << "Holes 16-15-14-13-12-11-10-9\n";
-        for (int h = 16; h >= 9; h--)
+        // Affichage du plateau: rangée du haut de HOLES à HOLES/2 + 1, rangée du bas de 1 à HOLES/2
+        result << "Holes " << HOLES;
+        for (int h = HOLES - 1; h > HOLES_PER_PLAYER; h--)
+        {
+            result << "-" << h;
+        }
+        result << "\n";
+        for (int h = HOLES; h > HOLES_PER_PLAYER; h--)
         {
             result << h << "(" << getTotalSeeds(h) << ") ";
         }
         result << "\n";
 
-        for (int h = 16; h >= 9; h--)
+        for (int h = HOLES; h > HOLES_PER_PLAYER; h--)
         {
             result << "R:" << holes.at(h).at(Color::RED)
                    << " B:" << holes.at(h).at(Color::BLUE)
@@ -243,14 +393,19 @@ public:
         }
         result << "\n";
 
-        result << "\nHoles 1-2-3-4-5-6-7-8\n";
-        for (int h = 1; h <= 8; h++)
+        result << "\nHoles 1";
+        for (int h = 2; h <= HOLES_PER_PLAYER; h++)
+        {
+            result << "-" << h;
+        }
+        result << "\n";
+        for (int h = 1; h <= HOLES_PER_PLAYER; h++)
         {
             result << h << "(" << getTotalSeeds(h) << ") ";
         }
         result << "\n";
 
-        for (int h = 1; h <= 8; h++)
+        for (int h = 1; h <= HOLES_PER_PLAYER; h++)
         {
             result << "R:" << holes.at(h).at(Color::RED)
                    << " B:" << holes.at(h).at(Color::BLUE)
@@ -262,4 +417,6 @@ public:
     }
 };
 
+using GameState = BasicGameState<StandardRules>;
+
 #endif // GAME_RULES_H
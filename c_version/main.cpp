@@ -3,11 +3,14 @@
  */
 
 #include "game_manager.h"
+#include "tournament.h"
 #include "game_rules.h"
+#include "profiler.h"
 #include <iostream>
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <thread>
 
 void printGameBoard(const GameState& state) {
     /**
@@ -107,9 +110,10 @@ void printAIMenu() {
     std::cout << "3. Min-Max - Profondeur 4" << std::endl;
     std::cout << "4. Alpha-Beta Pruning - Profondeur 5 (Recommandé)" << std::endl;
     std::cout << "5. Iterative Deepening DFS - Profondeur 6" << std::endl;
+    std::cout << "6. MCTS (UCT parallèle) - 2s par coup" << std::endl;
 }
 
-std::pair<std::string, std::map<std::string, int>> getAIChoice(const std::string& prompt = "Choisissez une IA (1-5): ") {
+std::pair<std::string, std::map<std::string, int>> getAIChoice(const std::string& prompt = "Choisissez une IA (1-6): ") {
     /**Demande à l'utilisateur de choisir une IA*/
     printAIMenu();
 
@@ -130,8 +134,10 @@ std::pair<std::string, std::map<std::string, int>> getAIChoice(const std::string
                 return {"alphabeta", {{"depth", 5}}};
             } else if (choice == 5) {
                 return {"iddfs", {{"depth", 6}}};
+            } else if (choice == 6) {
+                return {"mcts", {}};
             } else {
-                std::cout << "Choix invalide! Entrez 1, 2, 3, 4 ou 5." << std::endl;
+                std::cout << "Choix invalide! Entrez 1, 2, 3, 4, 5 ou 6." << std::endl;
             }
         } catch (...) {
             std::cout << "Veuillez entrer un nombre!" << std::endl;
@@ -139,6 +145,22 @@ std::pair<std::string, std::map<std::string, int>> getAIChoice(const std::string
     }
 }
 
+GameLogWriter* gameLog() {
+    /**Journal binaire des parties (GAME_LOG_FILE), ouvert au premier usage si LOG_GAMES*/
+    static GameLogWriter writer;
+    static bool opened = false;
+    if (!LOG_GAMES) {
+        return nullptr;
+    }
+    if (!opened) {
+        opened = true;
+        if (!writer.open(GAME_LOG_FILE)) {
+            std::cerr << "Impossible d'ouvrir le journal " << GAME_LOG_FILE << std::endl;
+        }
+    }
+    return writer.isOpen() ? &writer : nullptr;
+}
+
 void playHumanVsAI() {
     /**Lance une partie Humain vs IA*/
     std::cout << "\n" << std::string(80, '=') << std::endl;
@@ -172,7 +194,7 @@ void playHumanVsAI() {
     std::cout << "\nVous êtes le Joueur " << human_player << std::endl;
     std::cout << "L'IA sera le Joueur " << ai_player << std::endl;
 
-    auto [ai_type, ai_config] = getAIChoice("Choisissez l'IA pour le Joueur " + std::to_string(ai_player) + " (1-4): ");
+    auto [ai_type, ai_config] = getAIChoice("Choisissez l'IA pour le Joueur " + std::to_string(ai_player) + " (1-6): ");
 
     std::unique_ptr<GameManager> manager;
     if (human_player == 1) {
@@ -188,6 +210,7 @@ void playHumanVsAI() {
     // Pas d'affichage du plateau initial
     // printGameBoard(manager->state);
 
+    manager->game_log = gameLog();
     manager->playGame(true);
 
     // Affichage du résultat
@@ -233,6 +256,7 @@ void playAIVsAI() {
     // Pas d'affichage du plateau initial
     // printGameBoard(manager.state);
 
+    manager.game_log = gameLog();
     manager.playGame(true);
 
     // Affichage du résultat
@@ -250,54 +274,65 @@ void playAIVsAI() {
     std::cout << std::string(80, '=') << std::endl;
 }
 
-void playTournament() {
-    /**Lance un tournoi entre les 5 IA*/
-    // std::cout << "\n" << std::string(80, '=') << std::endl;
-    // std::cout << "TOURNOI - TOUS LES IA SE BATTENT" << std::endl;
-    // std::cout << std::string(80, '=') << std::endl;
+int readNumber(const std::string& prompt, int default_value) {
+    /**Lit un entier positif (entrée vide = valeur par défaut)*/
+    while (true) {
+        std::cout << prompt << std::flush;
+        std::string input;
+        std::getline(std::cin, input);
+        input.erase(0, input.find_first_not_of(" \t\n\r"));
+        input.erase(input.find_last_not_of(" \t\n\r") + 1);
+        if (input.empty()) {
+            return default_value;
+        }
+        try {
+            int value = std::stoi(input);
+            if (value > 0) {
+                return value;
+            }
+        } catch (...) {
+        }
+        std::cout << "Veuillez entrer un nombre positif!" << std::endl;
+    }
+}
 
-    Tournament tournament;
+void playTournament() {
+    /**
+    Lance un tournoi entre les 5 IA
+    Parties en parallèle, ouvertures aléatoires jouées dans les deux couleurs
+    */
+    std::cout << "\n" << std::string(80, '=') << std::endl;
+    std::cout << "TOURNOI - TOUS LES IA SE BATTENT" << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
 
-    std::vector<std::pair<std::string, std::map<std::string, int>>> ais = {
-        {"bfs", {{"depth", 2}}},
-        {"dfs", {{"depth", 3}}},
-        {"minimax", {{"depth", 4}}},
-        {"alphabeta", {{"depth", 5}}},
-        {"iddfs", {{"depth", 6}}}
+    std::vector<TournamentPlayer> ais = {
+        {"BFS", "bfs", {{"depth", 2}}},
+        {"DFS", "dfs", {{"depth", 3}}},
+        {"Min-Max", "minimax", {{"depth", 4}}},
+        {"Alpha-Beta", "alphabeta", {{"depth", 5}}},
+        {"ID-DFS", "iddfs", {{"depth", 6}}}
     };
 
-    std::vector<std::string> ai_names = {"BFS", "DFS", "Min-Max", "Alpha-Beta", "ID-DFS"};
-
-    // std::cout << "\nOuverture du tournoi..." << std::endl;
+    int opening_count = readNumber("Nombre d'ouvertures (2 parties chacune par paire, défaut 4): ", 4);
+    int threads = readNumber("Nombre de threads (défaut: tous les cœurs): ",
+                             std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
 
-    int match_count = 0;
-    for (size_t i = 0; i < ais.size(); i++) {
-        for (size_t j = 0; j < ais.size(); j++) {
-            if (i < j) {  // Évite les doublons
-                match_count++;
-                // std::cout << "\nMatch " << match_count << ": " << ai_names[i] << " vs " << ai_names[j] << std::endl;
+    std::vector<GameState> openings = Tournament::generateOpenings(opening_count, 6, 20250101);
 
-                GameManager manager(ais[i].first, ais[i].second, ais[j].first, ais[j].second);
-                manager.playGame(false);
-
-                GameStats stats = manager.getGameStats();
-                int winner = manager.state.getWinner();
-
-                if (winner == 0) {
-                    std::cout << "  Résultat: ÉGALITÉ (" << stats.player1_captured << " - " << stats.player2_captured << ")" << std::endl;
-                } else {
-                    std::string winner_name = (winner == 1) ? ai_names[i] : ai_names[j];
-                    std::cout << "  Gagnant: " << winner_name << " (" << stats.player1_captured << " - " << stats.player2_captured << ")" << std::endl;
-                }
-            }
-        }
-    }
+    std::cout << "\nOuverture du tournoi: " << ais.size() * (ais.size() - 1) / 2 * openings.size() * 2
+              << " parties sur " << threads << " thread(s)..." << std::endl;
 
+    Tournament tournament;
+    tournament.game_log = gameLog();
+    tournament.run(ais, openings, threads);
     tournament.printResults();
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     /**Boucle principale*/
+    // --profile: répartition des cycles par zone à la sortie (binaire compilé avec -DMANCALA_PROFILE)
+    bool profile = argc > 1 && std::string(argv[1]) == "--profile";
+
     // Force unbuffered output
     std::cout.sync_with_stdio(false);
     std::cout << std::unitbuf;
@@ -331,5 +366,9 @@ int main() {
         }
     }
 
+    if (profile) {
+        Profiler::report(std::cout);
+    }
+
     return 0;
 }
@@ -0,0 +1,169 @@
+/**
+ * Codage d'un coup sur un octet, partagé par toute la base (recherche, protocole, journaux)
+ *
+ *     code = (trou - 1) << 2 | type     type 0 = R, 1 = B, 2 = TR, 3 = TB
+ *
+ * 64 codes valides (trous 1 à 16), Move::NONE = 0xFF pour "aucun coup".
+ * Une variante à plus de 16 trous (RuleSet, game_rules.h) garde le même codage (trou 30: code 119);
+ * le texte et Move(trou, couleur) restent ceux du plateau standard: un tel code est valid()
+ * mais pas standard(), son texte est vide.
+ * Le même type que Playout (bit = 4 * rang + type) et que les journaux (game_log.h).
+ * Conversion texte <-> code par tables constexpr: ni allocation ni flux.
+ */
+
+#ifndef MOVE_H
+#define MOVE_H
+
+#include "game_rules.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+struct MoveText
+{
+    char text[5]; // "16TR" + '\0'
+    uint8_t length;
+};
+
+constexpr std::array<MoveText, 64> buildMoveTexts()
+{
+    /**Texte du protocole pour chacun des 64 codes ("1R", "1B", "1TR", "1TB", "2R", ...)*/
+    std::array<MoveText, 64> table{};
+    for (int code = 0; code < 64; code++)
+    {
+        MoveText &entry = table[code];
+        int hole = (code >> 2) + 1;
+        int type = code & 3;
+        int n = 0;
+        if (hole >= 10)
+        {
+            entry.text[n++] = '1';
+        }
+        entry.text[n++] = static_cast<char>('0' + hole % 10);
+        if (type >= 2)
+        {
+            entry.text[n++] = 'T';
+        }
+        entry.text[n++] = (type & 1) ? 'B' : 'R';
+        entry.text[n] = '\0';
+        entry.length = static_cast<uint8_t>(n);
+    }
+    return table;
+}
+
+inline constexpr std::array<MoveText, 64> MOVE_TEXTS = buildMoveTexts();
+
+struct Move
+{
+    static constexpr uint8_t NONE = 0xFF;
+
+    uint8_t code;
+
+    constexpr Move() : code(NONE) {}
+    constexpr explicit Move(uint8_t c) : code(c) {}
+    constexpr Move(int hole, Color color, Color transparent_as = Color::RED, bool use_transparent = false)
+        : code(encode(hole, color, transparent_as, use_transparent)) {}
+
+    static constexpr uint8_t encode(int hole, Color color, Color transparent_as, bool use_transparent)
+    {
+        int type = (color == Color::TRANSPARENT || use_transparent) ? (transparent_as == Color::BLUE ? 3 : 2)
+                                                                    : (color == Color::BLUE ? 1 : 0);
+        return (hole >= 1 && hole <= 16) ? static_cast<uint8_t>(((hole - 1) << 2) | type) : NONE;
+    }
+
+    constexpr bool valid() const { return code != NONE; }
+    constexpr bool standard() const { return code < MOVE_TEXTS.size(); } // trous 1 à 16
+    constexpr int hole() const { return (code >> 2) + 1; }
+    constexpr int type() const { return code & 3; }
+    constexpr bool useTransparent() const { return (code & 2) != 0; }
+    constexpr Color transparentAs() const { return (code & 1) ? Color::BLUE : Color::RED; }
+    constexpr Color color() const { return useTransparent() ? Color::TRANSPARENT : transparentAs(); }
+
+    constexpr bool operator==(Move other) const { return code == other.code; }
+    constexpr bool operator!=(Move other) const { return code != other.code; }
+
+    const char *text() const
+    {
+        /**Texte du protocole ("4TR"), chaîne vide pour NONE et les trous d'une variante au-delà de 16*/
+        return standard() ? MOVE_TEXTS[code].text : "";
+    }
+
+    size_t textLength() const
+    {
+        return standard() ? MOVE_TEXTS[code].length : 0;
+    }
+
+    static constexpr Move parse(const char *text, size_t length)
+    {
+        /**
+        Lit "3R", "14B", "5TR", "8tb" (casse indifférente, sans espaces)
+        Retourne Move() si le texte n'est pas un coup (trou hors de 1-16, suffixe inconnu)
+        */
+        size_t i = 0;
+        int hole = 0;
+        while (i < length && i < 2 && text[i] >= '0' && text[i] <= '9')
+        {
+            hole = hole * 10 + (text[i] - '0');
+            i++;
+        }
+        if (i == 0 || hole < 1 || hole > 16)
+        {
+            return Move();
+        }
+
+        int type = -1;
+        if (length - i == 1)
+        {
+            type = suffixType(text[i]);
+        }
+        else if (length - i == 2 && (text[i] == 'T' || text[i] == 't'))
+        {
+            type = suffixType(text[i + 1]);
+            type = type < 0 ? -1 : type + 2;
+        }
+        return type < 0 ? Move() : Move(static_cast<uint8_t>(((hole - 1) << 2) | type));
+    }
+
+private:
+    static constexpr int suffixType(char c)
+    {
+        return (c == 'R' || c == 'r') ? 0 : (c == 'B' || c == 'b') ? 1 : -1;
+    }
+};
+
+static_assert(sizeof(Move) == 1, "Move doit tenir sur un octet");
+static_assert(Move::parse("16TB", 4).code == 63 && Move::parse("1R", 2).code == 0, "Move::parse");
+static_assert(!Move::parse("17R", 3).valid() && !Move::parse("3T", 2).valid(), "Move::parse rejette");
+
+template <int Capacity>
+class BasicMoveList
+{
+public:
+    /**Liste de coups de taille fixe (trous d'un camp x 4 types au plus), sans allocation*/
+    static constexpr int CAPACITY = Capacity;
+
+    BasicMoveList() : count(0) {}
+
+    void push_back(Move move) { moves[count++] = move; }
+    void clear() { count = 0; }
+
+    size_t size() const { return static_cast<size_t>(count); }
+    bool empty() const { return count == 0; }
+
+    Move operator[](size_t i) const { return moves[i]; }
+    Move &operator[](size_t i) { return moves[i]; }
+    Move front() const { return moves[0]; }
+
+    const Move *begin() const { return moves; }
+    const Move *end() const { return moves + count; }
+    Move *begin() { return moves; }
+    Move *end() { return moves + count; }
+
+private:
+    Move moves[CAPACITY];
+    int count;
+};
+
+using MoveList = BasicMoveList<32>; // règles standard: 8 trous x 4 types
+
+#endif // MOVE_H
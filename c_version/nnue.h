@@ -0,0 +1,286 @@
+/**
+ * Évaluation par réseau de neurones quantifié (façon NNUE), optionnelle
+ *
+ * Entrées creuses, vues du joueur 1 (une entrée active vaut 1):
+ * - (couleur, trou, tranche du nombre de graines): 3 x 16 x 8 = 384, aucune pour un compteur nul
+ * - graines capturées par joueur, par tranches de 4: 2 x 25 = 50
+ * Couche 1: 434 -> 64, int16. L'accumulateur est le biais plus les colonnes des entrées actives.
+ * Activation: ReLU bornée à [0, QA]; sortie 64 -> 1, int16 x int16 -> int32 (SSE2 pmaddwd)
+ *
+ * L'accumulateur d'un enfant se déduit de celui du parent: seules les cases (couleur, trou)
+ * dont la tranche change au semis ou à la capture retirent / ajoutent une colonne.
+ *
+ * Fichier de poids (petit-boutiste): "MNNUE" + version, entrées et cachés (uint16), puis
+ * W1 [entrée][caché], b1 [caché], W2 [caché] (int16) et b2 (int32). Écrit par tune_eval --nnue.
+ */
+
+#ifndef NNUE_H
+#define NNUE_H
+
+#include "game_rules.h"
+#include "game_engine.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+
+constexpr std::array<uint8_t, 256> buildCountBuckets()
+{
+    /**Tranche d'un compteur de graines: 1, 2, 3, 4, 5-6, 7-9, 10-15, 16+ (0xFF: trou vide)*/
+    std::array<uint8_t, 256> buckets{};
+    buckets[0] = 0xFF;
+    for (int n = 1; n < 256; n++)
+    {
+        buckets[n] = static_cast<uint8_t>(n <= 4 ? n - 1 : n <= 6 ? 4 : n <= 9 ? 5 : n <= 15 ? 6 : 7);
+    }
+    return buckets;
+}
+
+inline constexpr std::array<uint8_t, 256> NNUE_COUNT_BUCKETS = buildCountBuckets();
+
+struct NnueAccumulator
+{
+    alignas(16) int16_t values[64]; // un par neurone caché (NnueNetwork::HIDDEN)
+};
+
+class NnueNetwork
+{
+public:
+    static constexpr int COUNT_BUCKETS = 8;
+    static constexpr int CAPTURE_BUCKETS = 25; // 0-3, 4-7, ..., 96
+    static constexpr int CELL_INPUTS = 3 * 16 * COUNT_BUCKETS;
+    static constexpr int INPUTS = CELL_INPUTS + 2 * CAPTURE_BUCKETS;
+    static constexpr int HIDDEN = 64;
+    static constexpr int MAX_ACTIVE = 3 * 16 + 2;
+
+    static constexpr int QA = 127;           // activation 1.0 -> 127
+    static constexpr int QB = 64;            // poids de sortie 1.0 -> 64
+    static constexpr int OUTPUT_SCALE = 100; // score = 100 x logit de victoire du joueur 1
+
+    alignas(16) int16_t w1[INPUTS][HIDDEN];
+    alignas(16) int16_t b1[HIDDEN];
+    alignas(16) int16_t w2[HIDDEN];
+    int32_t b2;
+
+    NnueNetwork() : w1{}, b1{}, w2{}, b2(0) {}
+
+    static int cellInput(int cell, int count)
+    {
+        /**Entrée de la case cell = couleur * 16 + trou - 1 (rangement de HoleTable), -1 si vide*/
+        int bucket = NNUE_COUNT_BUCKETS[count];
+        return bucket == 0xFF ? -1 : cell * COUNT_BUCKETS + bucket;
+    }
+
+    static int captureInput(int player, int captured)
+    {
+        return CELL_INPUTS + (player - 1) * CAPTURE_BUCKETS + captured / 4;
+    }
+
+    static int activeInputs(const GameState &state, int *inputs)
+    {
+        /**Entrées actives de la position (au plus MAX_ACTIVE), retourne leur nombre*/
+        const uint8_t *counts = &state.holes.seeds[0][0];
+        int n = 0;
+        for (int cell = 0; cell < 48; cell++)
+        {
+            int input = cellInput(cell, counts[cell]);
+            if (input >= 0)
+            {
+                inputs[n++] = input;
+            }
+        }
+        inputs[n++] = captureInput(1, state.captured_seeds[1]);
+        inputs[n++] = captureInput(2, state.captured_seeds[2]);
+        return n;
+    }
+
+    void refresh(const GameState &state, NnueAccumulator &acc) const
+    {
+        /**Accumulateur recalculé depuis les entrées actives*/
+        int inputs[MAX_ACTIVE];
+        int n = activeInputs(state, inputs);
+        std::memcpy(acc.values, b1, sizeof(b1));
+        for (int k = 0; k < n; k++)
+        {
+            addColumn(acc, inputs[k]);
+        }
+    }
+
+    void update(const GameState &parent, const GameState &child, const NnueAccumulator &from,
+                NnueAccumulator &to) const
+    {
+        /**
+        Accumulateur de child à partir de celui de parent: cases modifiées repérées par
+        comparaison vectorielle des plans, colonnes retirées / ajoutées si la tranche change
+        */
+        to = from;
+        for (int c = 0; c < 3; c++)
+        {
+            const uint8_t *before = parent.holes.seeds[c];
+            const uint8_t *after = child.holes.seeds[c];
+            uint32_t changed = changedMask(before, after);
+            while (changed)
+            {
+                int i = __builtin_ctz(changed);
+                changed &= changed - 1;
+                int old_input = cellInput(16 * c + i, before[i]);
+                int new_input = cellInput(16 * c + i, after[i]);
+                if (old_input != new_input)
+                {
+                    if (old_input >= 0)
+                    {
+                        subColumn(to, old_input);
+                    }
+                    if (new_input >= 0)
+                    {
+                        addColumn(to, new_input);
+                    }
+                }
+            }
+        }
+        for (int player = 1; player <= 2; player++)
+        {
+            int old_input = captureInput(player, parent.captured_seeds[player]);
+            int new_input = captureInput(player, child.captured_seeds[player]);
+            if (old_input != new_input)
+            {
+                subColumn(to, old_input);
+                addColumn(to, new_input);
+            }
+        }
+    }
+
+    int output(const NnueAccumulator &acc) const
+    {
+        /**Score du joueur 1 (OUTPUT_SCALE x logit): ReLU bornée puis produit scalaire int16*/
+        int32_t sum = 0;
+#ifdef MANCALA_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i top = _mm_set1_epi16(QA);
+        __m128i total = _mm_setzero_si128();
+        for (int j = 0; j < HIDDEN; j += 8)
+        {
+            __m128i v = _mm_load_si128(reinterpret_cast<const __m128i *>(acc.values + j));
+            v = _mm_min_epi16(_mm_max_epi16(v, zero), top);
+            __m128i w = _mm_load_si128(reinterpret_cast<const __m128i *>(w2 + j));
+            total = _mm_add_epi32(total, _mm_madd_epi16(v, w));
+        }
+        total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(1, 0, 3, 2)));
+        total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(2, 3, 0, 1)));
+        sum = _mm_cvtsi128_si32(total);
+#else
+        for (int j = 0; j < HIDDEN; j++)
+        {
+            int v = acc.values[j] < 0 ? 0 : acc.values[j] > QA ? QA : acc.values[j];
+            sum += v * w2[j];
+        }
+#endif
+        return static_cast<int>((static_cast<int64_t>(sum) + b2) * OUTPUT_SCALE / (QA * QB));
+    }
+
+    int evaluate(const GameState &state, int player) const
+    {
+        /**Score de la position pour player (accumulateur recalculé)*/
+        NnueAccumulator acc;
+        refresh(state, acc);
+        int score = output(acc);
+        return player == 1 ? score : -score;
+    }
+
+    bool load(const std::string &path)
+    {
+        /**Lit un fichier de poids; le réseau n'est modifié que si le fichier est complet*/
+        std::ifstream in(path, std::ios::binary);
+        char magic[6];
+        uint16_t dims[2];
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, NNUE_MAGIC, sizeof(magic)) != 0 ||
+            !in.read(reinterpret_cast<char *>(dims), sizeof(dims)) || dims[0] != INPUTS || dims[1] != HIDDEN)
+        {
+            return false;
+        }
+        std::unique_ptr<NnueNetwork> loaded(new NnueNetwork()); // 55 Ko: hors de la pile
+        bool ok = static_cast<bool>(in.read(reinterpret_cast<char *>(loaded->w1), sizeof(w1)) &&
+                                    in.read(reinterpret_cast<char *>(loaded->b1), sizeof(b1)) &&
+                                    in.read(reinterpret_cast<char *>(loaded->w2), sizeof(w2)) &&
+                                    in.read(reinterpret_cast<char *>(&loaded->b2), sizeof(b2)));
+        if (ok)
+        {
+            *this = *loaded;
+        }
+        return ok;
+    }
+
+    bool save(const std::string &path) const
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        uint16_t dims[2] = {INPUTS, HIDDEN};
+        out.write(NNUE_MAGIC, sizeof(NNUE_MAGIC));
+        out.write(reinterpret_cast<const char *>(dims), sizeof(dims));
+        out.write(reinterpret_cast<const char *>(w1), sizeof(w1));
+        out.write(reinterpret_cast<const char *>(b1), sizeof(b1));
+        out.write(reinterpret_cast<const char *>(w2), sizeof(w2));
+        out.write(reinterpret_cast<const char *>(&b2), sizeof(b2));
+        return static_cast<bool>(out);
+    }
+
+private:
+    static constexpr char NNUE_MAGIC[6] = {'M', 'N', 'N', 'U', 'E', 1}; // magic + version
+
+    static uint32_t changedMask(const uint8_t *before, const uint8_t *after)
+    {
+        /**Masque 16 bits des trous dont le compteur diffère*/
+#ifdef MANCALA_SSE2
+        __m128i a = _mm_load_si128(reinterpret_cast<const __m128i *>(before));
+        __m128i b = _mm_load_si128(reinterpret_cast<const __m128i *>(after));
+        return ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & 0xFFFF;
+#else
+        uint32_t mask = 0;
+        for (int i = 0; i < 16; i++)
+        {
+            mask |= static_cast<uint32_t>(before[i] != after[i]) << i;
+        }
+        return mask;
+#endif
+    }
+
+    void addColumn(NnueAccumulator &acc, int input) const
+    {
+        // Additions int16 modulo 2^16: retirer une colonne annule exactement son ajout
+        const int16_t *column = w1[input];
+#ifdef MANCALA_SSE2
+        for (int j = 0; j < HIDDEN; j += 8)
+        {
+            __m128i *v = reinterpret_cast<__m128i *>(acc.values + j);
+            _mm_store_si128(v, _mm_add_epi16(_mm_load_si128(v), _mm_load_si128(reinterpret_cast<const __m128i *>(column + j))));
+        }
+#else
+        for (int j = 0; j < HIDDEN; j++)
+        {
+            acc.values[j] = static_cast<int16_t>(acc.values[j] + column[j]);
+        }
+#endif
+    }
+
+    void subColumn(NnueAccumulator &acc, int input) const
+    {
+        const int16_t *column = w1[input];
+#ifdef MANCALA_SSE2
+        for (int j = 0; j < HIDDEN; j += 8)
+        {
+            __m128i *v = reinterpret_cast<__m128i *>(acc.values + j);
+            _mm_store_si128(v, _mm_sub_epi16(_mm_load_si128(v), _mm_load_si128(reinterpret_cast<const __m128i *>(column + j))));
+        }
+#else
+        for (int j = 0; j < HIDDEN; j++)
+        {
+            acc.values[j] = static_cast<int16_t>(acc.values[j] - column[j]);
+        }
+#endif
+    }
+};
+
+static_assert(sizeof(NnueAccumulator::values) / sizeof(int16_t) == NnueNetwork::HIDDEN, "accumulateur: un int16 par caché");
+
+#endif // NNUE_H
@@ -0,0 +1,327 @@
+/**
+ * Notation compacte des positions (texte et binaire), sans allocation
+ *
+ * Texte (façon FEN): les 16 trous séparés par '/', puis captures J1, captures J2,
+ * joueur au trait et nombre de coups joués:
+ *     2.2.2/2.2.2/.../2.2.2 0 0 1 0
+ * Un trou s'écrit rouges.bleues.transparentes, ou '-' s'il est vide.
+ * parse() et unpack() refusent plus de 32 graines d'une couleur sur le plateau
+ * (donc plus de 64 dans un trou): le moteur n'a pas à traiter ces positions.
+ *
+ * Binaire (32 octets = 256 bits, petit-boutiste):
+ * - bits 0-239:   48 compteurs de 5 bits, rangés comme HoleTable (couleur, puis trou)
+ * - bits 240-246: graines capturées par J1
+ * - bits 247-255: nombre de coups joués
+ * Le joueur au trait se déduit de la parité du nombre de coups, les captures de J2
+ * du total de 96 graines. pack() échoue si le joueur au trait ne suit pas cette parité,
+ * ou pour un compteur de 32 (les 32 graines d'une couleur dans un seul trou,
+ * inatteignable en pratique), non représentable.
+ */
+
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include "game_rules.h"
+#include "game_engine.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+struct PackedPosition
+{
+    uint8_t bytes[32];
+
+    bool operator==(const PackedPosition &other) const
+    {
+        return std::memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+    }
+};
+
+static_assert(sizeof(PackedPosition) == 32, "PackedPosition doit tenir en 32 octets");
+#if defined(__BYTE_ORDER__)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "pack/unpack lisent les compteurs par mots de 8 octets petit-boutistes");
+#endif
+
+class Notation
+{
+public:
+    static constexpr int TOTAL_SEEDS = StandardRules::TOTAL_SEEDS; // 96
+    static constexpr int COLOR_SEEDS = StandardRules::SEEDS_PER_COLOR * StandardRules::HOLES; // 32 par couleur
+    static constexpr size_t MAX_TEXT_LENGTH = 224; // pire cas: 16 trous "999.999.999", séparateurs et 4 champs
+
+    static size_t write(const GameState &state, char *out, size_t capacity)
+    {
+        /**
+        Écrit la notation texte dans out (terminée par '\0' si la place le permet)
+        Retourne la longueur écrite, 0 si capacity est insuffisante
+        */
+        char buffer[MAX_TEXT_LENGTH];
+        char *p = buffer;
+        for (int i = 0; i < 16; i++)
+        {
+            if (i > 0)
+            {
+                *p++ = '/';
+            }
+            int r = state.holes.seeds[0][i];
+            int b = state.holes.seeds[1][i];
+            int t = state.holes.seeds[2][i];
+            if ((r | b | t) == 0)
+            {
+                *p++ = '-';
+                continue;
+            }
+            p = writeNumber(p, r);
+            *p++ = '.';
+            p = writeNumber(p, b);
+            *p++ = '.';
+            p = writeNumber(p, t);
+        }
+        *p++ = ' ';
+        p = writeNumber(p, state.captured_seeds[1]);
+        *p++ = ' ';
+        p = writeNumber(p, state.captured_seeds[2]);
+        *p++ = ' ';
+        p = writeNumber(p, state.current_player);
+        *p++ = ' ';
+        p = writeNumber(p, state.move_count);
+
+        size_t length = static_cast<size_t>(p - buffer);
+        if (length > capacity)
+        {
+            return 0;
+        }
+        std::memcpy(out, buffer, length);
+        if (length < capacity)
+        {
+            out[length] = '\0';
+        }
+        return length;
+    }
+
+    static bool parse(const char *text, size_t length, GameState &state)
+    {
+        /**
+        Lit la notation texte; state n'est modifié que si la position est valide
+        (16 trous, 96 graines au total, au plus 32 de chaque couleur sur le plateau,
+        joueur 1 ou 2, au plus 400 coups)
+        Un trou a donc au plus 64 graines: le semis (SOW_TABLE) n'est jamais indexé au-delà
+        */
+        const char *p = text;
+        const char *end = text + length;
+        GameState result;
+        int on_board = 0;
+        int color_total[3] = {};
+
+        for (int i = 0; i < 16; i++)
+        {
+            if (i > 0 && !expect(p, end, '/'))
+            {
+                return false;
+            }
+            if (p < end && *p == '-')
+            {
+                p++;
+                for (int c = 0; c < 3; c++)
+                {
+                    result.holes.seeds[c][i] = 0;
+                }
+                continue;
+            }
+            for (int c = 0; c < 3; c++)
+            {
+                int count;
+                if ((c > 0 && !expect(p, end, '.')) || !readNumber(p, end, count) ||
+                    (color_total[c] += count) > COLOR_SEEDS)
+                {
+                    return false;
+                }
+                result.holes.seeds[c][i] = static_cast<uint8_t>(count);
+                on_board += count;
+            }
+        }
+
+        int c1, c2, player, moves;
+        if (!readField(p, end, c1) || !readField(p, end, c2) || !readField(p, end, player) || !readField(p, end, moves))
+        {
+            return false;
+        }
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+        {
+            p++;
+        }
+        if (p != end || on_board + c1 + c2 != TOTAL_SEEDS || (player != 1 && player != 2) ||
+            moves > GameState::MAX_MOVES)
+        {
+            return false;
+        }
+
+        result.captured_seeds[1] = c1;
+        result.captured_seeds[2] = c2;
+        result.current_player = player;
+        result.move_count = moves;
+        planeBoardFeatures(result.holes.seeds, result.features);
+        state = result;
+        return true;
+    }
+
+    static bool parse(const char *text, GameState &state)
+    {
+        return parse(text, std::strlen(text), state);
+    }
+
+    static bool pack(const GameState &state, PackedPosition &packed)
+    {
+        /**
+        Forme binaire de 32 octets (échoue si un compteur dépasse 31 ou si le joueur
+        au trait n'est pas celui de la parité du nombre de coups)
+        Les 48 compteurs sont traités par groupes de 8: 8 octets -> 40 bits -> 5 octets
+        */
+        if (state.current_player != 1 + (state.move_count & 1))
+        {
+            return false;
+        }
+        const uint8_t *counts = &state.holes.seeds[0][0];
+        uint64_t overflow = 0;
+        for (int group = 0; group < 6; group++)
+        {
+            uint64_t bytes;
+            std::memcpy(&bytes, counts + 8 * group, 8);
+            overflow |= bytes;
+            store40(packed.bytes + 5 * group, compress8(bytes));
+        }
+        if (overflow & 0xE0E0E0E0E0E0E0E0ULL)
+        {
+            return false;
+        }
+
+        uint32_t tail = static_cast<uint32_t>(state.captured_seeds[1]) | (static_cast<uint32_t>(state.move_count) << 7);
+        packed.bytes[30] = static_cast<uint8_t>(tail);
+        packed.bytes[31] = static_cast<uint8_t>(tail >> 8);
+        return true;
+    }
+
+    static bool unpack(const PackedPosition &packed, GameState &state)
+    {
+        /**
+        Relit la forme binaire; state n'est modifié que si la position est cohérente
+        (mêmes bornes que parse: au plus 32 graines de chaque couleur sur le plateau)
+        */
+        uint64_t groups[6];
+        int on_board = 0;
+        bool overflow = false;
+        for (int group = 0; group < 6; group += 2)
+        {
+            // Une couleur = deux groupes de 8 trous; somme des octets (chacun <= 31, total <= 248: pas de retenue)
+            groups[group] = expand8(load40(packed.bytes + 5 * group));
+            groups[group + 1] = expand8(load40(packed.bytes + 5 * (group + 1)));
+            int color = static_cast<int>((groups[group] * 0x0101010101010101ULL) >> 56) +
+                        static_cast<int>((groups[group + 1] * 0x0101010101010101ULL) >> 56);
+            overflow |= color > COLOR_SEEDS;
+            on_board += color;
+        }
+        uint32_t tail = packed.bytes[30] | (static_cast<uint32_t>(packed.bytes[31]) << 8);
+        int c1 = static_cast<int>(tail & 127);
+        int moves = static_cast<int>(tail >> 7);
+        if (overflow || on_board + c1 > TOTAL_SEEDS || moves > GameState::MAX_MOVES)
+        {
+            return false;
+        }
+
+        std::memcpy(state.holes.seeds, groups, sizeof(groups));
+        state.captured_seeds[0] = 0;
+        state.captured_seeds[1] = c1;
+        state.captured_seeds[2] = TOTAL_SEEDS - c1 - on_board;
+        state.move_count = moves;
+        state.current_player = 1 + (moves & 1);
+        planeBoardFeatures(state.holes.seeds, state.features);
+        return true;
+    }
+
+private:
+    static uint64_t compress8(uint64_t x)
+    {
+        /**8 champs de 5 bits (un par octet) -> 40 bits contigus, en trois étapes SWAR*/
+        x &= 0x1F1F1F1F1F1F1F1FULL;
+        x = (x & 0x001F001F001F001FULL) | ((x & 0x1F001F001F001F00ULL) >> 3);
+        x = (x & 0x000003FF000003FFULL) | ((x & 0x03FF000003FF0000ULL) >> 6);
+        return (x & 0xFFFFFULL) | ((x >> 12) & (0xFFFFFULL << 20));
+    }
+
+    static uint64_t expand8(uint64_t x)
+    {
+        /**Inverse de compress8: 40 bits -> 8 octets*/
+        x = (x & 0xFFFFFULL) | ((x & (0xFFFFFULL << 20)) << 12);
+        x = (x & 0x000003FF000003FFULL) | ((x & 0x000FFC00000FFC00ULL) << 6);
+        return (x & 0x001F001F001F001FULL) | ((x & 0x03E003E003E003E0ULL) << 3);
+    }
+
+    static void store40(uint8_t *out, uint64_t bits)
+    {
+        out[0] = static_cast<uint8_t>(bits);
+        out[1] = static_cast<uint8_t>(bits >> 8);
+        out[2] = static_cast<uint8_t>(bits >> 16);
+        out[3] = static_cast<uint8_t>(bits >> 24);
+        out[4] = static_cast<uint8_t>(bits >> 32);
+    }
+
+    static uint64_t load40(const uint8_t *in)
+    {
+        return static_cast<uint64_t>(in[0]) | (static_cast<uint64_t>(in[1]) << 8) |
+               (static_cast<uint64_t>(in[2]) << 16) | (static_cast<uint64_t>(in[3]) << 24) |
+               (static_cast<uint64_t>(in[4]) << 32);
+    }
+
+    static char *writeNumber(char *p, int value)
+    {
+        // Valeurs de 0 à 400
+        if (value >= 100)
+        {
+            *p++ = static_cast<char>('0' + value / 100);
+        }
+        if (value >= 10)
+        {
+            *p++ = static_cast<char>('0' + (value / 10) % 10);
+        }
+        *p++ = static_cast<char>('0' + value % 10);
+        return p;
+    }
+
+    static bool readNumber(const char *&p, const char *end, int &value)
+    {
+        const char *start = p;
+        value = 0;
+        while (p < end && *p >= '0' && *p <= '9' && p - start < 3)
+        {
+            value = value * 10 + (*p - '0');
+            p++;
+        }
+        return p > start && (p == end || *p < '0' || *p > '9');
+    }
+
+    static bool readField(const char *&p, const char *end, int &value)
+    {
+        /**Un ou plusieurs espaces puis un entier*/
+        if (p >= end || *p != ' ')
+        {
+            return false;
+        }
+        while (p < end && *p == ' ')
+        {
+            p++;
+        }
+        return readNumber(p, end, value);
+    }
+
+    static bool expect(const char *&p, const char *end, char c)
+    {
+        if (p < end && *p == c)
+        {
+            p++;
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif // NOTATION_H
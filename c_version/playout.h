@@ -0,0 +1,162 @@
+/**
+ * Simulations rapides (playouts) pour les méthodes de Monte Carlo et l'auto-jeu
+ * - Aucune allocation: l'état est joué sur place
+ * - Générateur xorshift64*
+ * - Coups tirés dans le masque de bits des coups légaux
+ * - Chemin d'exécution spécialisé (sans validation ni debug) pour jouer un coup,
+ *   avec le semis vectoriel de GameEngine::sow
+ */
+
+#ifndef PLAYOUT_H
+#define PLAYOUT_H
+
+#include "game_rules.h"
+#include "game_engine.h"
+#include "move.h"
+#include <cstdint>
+
+class XorShiftRng
+{
+public:
+    /**Générateur xorshift64* - quelques cycles par tirage*/
+    uint64_t state;
+
+    explicit XorShiftRng(uint64_t seed = 0x9E3779B97F4A7C15ULL) : state(seed ? seed : 0x9E3779B97F4A7C15ULL) {}
+
+    uint64_t next()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+    uint32_t below(uint32_t n)
+    {
+        /**Entier uniforme dans [0, n) sans division*/
+        return static_cast<uint32_t>(((next() >> 32) * n) >> 32);
+    }
+};
+
+enum class PlayoutPolicy
+{
+    UNIFORM,       // coup uniforme parmi les coups légaux
+    CAPTURE_BIASED // entre deux coups tirés, garde celui qui capture le plus
+};
+
+class Playout
+{
+public:
+    /**
+    Codage des coups dans le masque: bit = 4 * i + type
+    - i: rang du trou parmi les 8 trous du joueur (trou = 2 * i + joueur)
+    - type: 0 = R, 1 = B, 2 = TR, 3 = TB
+    */
+    enum MoveType
+    {
+        MOVE_R = 0,
+        MOVE_B = 1,
+        MOVE_TR = 2,
+        MOVE_TB = 3
+    };
+
+    static uint32_t legalMoveMask(const GameState &state, int player)
+    {
+        /**Masque 32 bits des coups légaux du joueur*/
+        const uint8_t(*seeds)[16] = state.holes.seeds;
+        uint32_t mask = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            int idx = 2 * i + player - 1;
+            uint32_t r = seeds[0][idx] != 0;
+            uint32_t b = seeds[1][idx] != 0;
+            uint32_t t = seeds[2][idx] != 0;
+            mask |= (r | (b << 1) | (t << 2) | (t << 3)) << (4 * i);
+        }
+        return mask;
+    }
+
+    static int holeOf(int bit, int player)
+    {
+        /**Numéro du trou (1-16) d'un bit du masque*/
+        return 2 * (bit >> 2) + player;
+    }
+
+    static Move toMove(int bit, int player)
+    {
+        /**Coup codé sur un octet (move.h): même type, trou = holeOf(bit, player)*/
+        return Move(static_cast<uint8_t>(((holeOf(bit, player) - 1) << 2) | (bit & 3)));
+    }
+
+    static void applyFast(GameState &state, int bit)
+    {
+        /**
+        Joue le coup `bit` (supposé légal) pour le joueur courant
+        Même règles que GameEngine::playMove, sans vérification ni affichage
+        */
+        uint8_t(*seeds)[16] = state.holes.seeds;
+        int player = state.current_player;
+        int src = holeOf(bit, player) - 1;
+        int type = bit & 3;
+
+        // Semis vectoriel partagé avec GameEngine (règle: 0 = rouge pour R/TR, 1 = bleu pour B/TB)
+        int last = GameEngine::sow(seeds, src, type & 1, type >= MOVE_TR);
+
+        // Capture en temps constant (chaîne résolue sur masque de bits)
+        int captured = GameEngine::capture(seeds, last);
+
+        state.captured_seeds[player] += captured;
+        planeBoardFeatures(seeds, state.features);
+        state.move_count++;
+        state.current_player = 3 - player;
+    }
+
+    static int randomMove(uint32_t mask, XorShiftRng &rng)
+    {
+        /**Bit uniforme parmi les bits à 1 du masque (non nul)*/
+        uint32_t k = rng.below(static_cast<uint32_t>(__builtin_popcount(mask)));
+        for (; k > 0; k--)
+        {
+            mask &= mask - 1;
+        }
+        return __builtin_ctz(mask);
+    }
+
+    static int run(GameState &state, XorShiftRng &rng, PlayoutPolicy policy = PlayoutPolicy::UNIFORM)
+    {
+        /**
+        Joue la partie jusqu'à la fin sur place
+        Retourne le gagnant: 1, 2 ou 0 (égalité)
+        */
+        while (!state.isGameOver())
+        {
+            uint32_t mask = legalMoveMask(state, state.current_player);
+            if (mask == 0)
+            {
+                break;
+            }
+
+            int bit = randomMove(mask, rng);
+            if (policy == PlayoutPolicy::CAPTURE_BIASED)
+            {
+                int other = randomMove(mask, rng);
+                if (other != bit && captureGain(state, other) > captureGain(state, bit))
+                {
+                    bit = other;
+                }
+            }
+            applyFast(state, bit);
+        }
+        return state.getWinner();
+    }
+
+private:
+    static int captureGain(const GameState &state, int bit)
+    {
+        GameState next = state;
+        applyFast(next, bit);
+        return next.captured_seeds[state.current_player] - state.captured_seeds[state.current_player];
+    }
+};
+
+#endif // PLAYOUT_H
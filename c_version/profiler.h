@@ -0,0 +1,181 @@
+/**
+ * Zones de profilage des chemins critiques (moteur et recherche)
+ * - PROFILE_ZONE(zone) mesure la portée courante en cycles (rdtsc)
+ * - Compteurs par zone et par thread, sans verrou sur le chemin mesuré
+ * - Ne génère aucun code sauf si MANCALA_PROFILE est défini:
+ *       g++ ... -DMANCALA_PROFILE
+ * - Les zones sont inclusives: SEARCH_NODE contient MOVEGEN, SOW, CAPTURE, EVAL...
+ * - Chaque zone coûte quelques dizaines de cycles: comparer les zones entre elles,
+ *   pas avec un binaire sans profilage
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+
+enum ProfileZone
+{
+    PROFILE_MOVEGEN,
+    PROFILE_SOW,
+    PROFILE_CAPTURE,
+    PROFILE_EVAL,
+    PROFILE_HASH_PROBE,
+    PROFILE_SEARCH_NODE,
+    PROFILE_ZONE_COUNT
+};
+
+#ifdef MANCALA_PROFILE
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+struct ProfileCounters
+{
+    uint64_t cycles[PROFILE_ZONE_COUNT] = {};
+    uint64_t calls[PROFILE_ZONE_COUNT] = {};
+};
+
+class Profiler
+{
+public:
+    static uint64_t now()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        // Pas de compteur de cycles: nanosecondes
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    static ProfileCounters &local()
+    {
+        /**Compteurs du thread courant (enregistrés une fois, conservés après la fin du thread)*/
+        thread_local ProfileCounters *counters = registerThread();
+        return *counters;
+    }
+
+    static void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        for (auto &counters : threads())
+        {
+            *counters = ProfileCounters();
+        }
+    }
+
+    static void report(std::ostream &out)
+    {
+        /**Répartition des cycles par zone (tous threads), puis par thread s'il y en a plusieurs*/
+        std::lock_guard<std::mutex> lock(mutex());
+        ProfileCounters total;
+        for (auto &counters : threads())
+        {
+            for (int z = 0; z < PROFILE_ZONE_COUNT; z++)
+            {
+                total.cycles[z] += counters->cycles[z];
+                total.calls[z] += counters->calls[z];
+            }
+        }
+
+        out << "\n=== Profil (cycles inclusifs par zone) ===\n";
+        printCounters(out, total);
+        if (threads().size() > 1)
+        {
+            for (size_t t = 0; t < threads().size(); t++)
+            {
+                out << "--- thread " << t << " ---\n";
+                printCounters(out, *threads()[t]);
+            }
+        }
+    }
+
+private:
+    static std::mutex &mutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+    static std::vector<std::unique_ptr<ProfileCounters>> &threads()
+    {
+        static std::vector<std::unique_ptr<ProfileCounters>> list;
+        return list;
+    }
+
+    static ProfileCounters *registerThread()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        threads().push_back(std::make_unique<ProfileCounters>());
+        return threads().back().get();
+    }
+
+    static void printCounters(std::ostream &out, const ProfileCounters &counters)
+    {
+        static const char *names[PROFILE_ZONE_COUNT] = {"movegen", "sow", "capture", "eval", "hash_probe", "search_node"};
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-12s %14s %16s %12s\n", "zone", "appels", "cycles", "cycles/appel");
+        out << line;
+        for (int z = 0; z < PROFILE_ZONE_COUNT; z++)
+        {
+            if (counters.calls[z] == 0)
+            {
+                continue;
+            }
+            std::snprintf(line, sizeof(line), "%-12s %14llu %16llu %12.1f\n", names[z],
+                          static_cast<unsigned long long>(counters.calls[z]),
+                          static_cast<unsigned long long>(counters.cycles[z]),
+                          static_cast<double>(counters.cycles[z]) / counters.calls[z]);
+            out << line;
+        }
+    }
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(ProfileZone z) : zone(z), start(Profiler::now()) {}
+
+    ~ProfileScope()
+    {
+        ProfileCounters &counters = Profiler::local();
+        counters.cycles[zone] += Profiler::now() - start;
+        counters.calls[zone]++;
+    }
+
+private:
+    ProfileZone zone;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(zone) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(zone)
+
+#else
+
+class Profiler
+{
+public:
+    static void reset() {}
+
+    static void report(std::ostream &out)
+    {
+        out << "Profilage désactivé: recompiler avec -DMANCALA_PROFILE" << std::endl;
+    }
+};
+
+#define PROFILE_ZONE(zone) ((void)0)
+
+#endif // MANCALA_PROFILE
+
+#endif // PROFILER_H
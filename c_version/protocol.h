@@ -0,0 +1,197 @@
+/**
+ * Couche protocole de l'arbitre, sans allocation
+ * - Lecture de stdin par blocs dans un tampon fixe, découpage en lignes sur place
+ * - Coups lus par Move::parse, écrits depuis la table MOVE_TEXTS (move.h)
+ * - Chaque réponse (coup, éventuellement suivi de RESULT) part en un seul write()
+ * L'arbitre décompte nos entrées/sorties des 3 secondes: aucun flux C++, aucune
+ * chaîne temporaire, aucun tampon intermédiaire de la libc.
+ */
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include "move.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <unistd.h>
+
+class ProtocolReader
+{
+public:
+    /**Lignes de l'arbitre lues dans un tampon fixe (une ligne plus longue que le tampon est ignorée)*/
+    static constexpr size_t CAPACITY = 4096;
+
+    explicit ProtocolReader(int input_fd = STDIN_FILENO) : fd(input_fd) {}
+
+    bool nextLine(const char *&text, size_t &length)
+    {
+        /**
+        Ligne suivante, sans espaces ni '\r' de bord; text pointe dans le tampon interne
+        et reste valide jusqu'à l'appel suivant. false en fin de flux.
+        */
+        while (true)
+        {
+            char *newline = static_cast<char *>(std::memchr(buffer + begin, '\n', end - begin));
+            if (newline)
+            {
+                char *line = buffer + begin;
+                begin = static_cast<size_t>(newline - buffer) + 1;
+                if (discarding)
+                {
+                    discarding = false;
+                    continue;
+                }
+                trim(line, newline, text, length);
+                return true;
+            }
+
+            if (eof)
+            {
+                // Dernière ligne sans '\n'
+                if (end > begin && !discarding)
+                {
+                    trim(buffer + begin, buffer + end, text, length);
+                    begin = end;
+                    return true;
+                }
+                return false;
+            }
+
+            if (begin > 0)
+            {
+                std::memmove(buffer, buffer + begin, end - begin);
+                end -= begin;
+                begin = 0;
+            }
+            if (end == CAPACITY)
+            {
+                end = 0;
+                discarding = true;
+            }
+
+            ssize_t n = ::read(fd, buffer + end, CAPACITY - end);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                eof = true;
+                continue;
+            }
+            end += static_cast<size_t>(n);
+        }
+    }
+
+private:
+    int fd;
+    char buffer[CAPACITY];
+    size_t begin = 0;
+    size_t end = 0;
+    bool eof = false;
+    bool discarding = false;
+
+    static bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    static void trim(const char *first, const char *last, const char *&text, size_t &length)
+    {
+        while (first < last && isSpace(*first))
+        {
+            first++;
+        }
+        while (last > first && isSpace(last[-1]))
+        {
+            last--;
+        }
+        text = first;
+        length = static_cast<size_t>(last - first);
+    }
+};
+
+class ProtocolWriter
+{
+public:
+    /**Réponse assemblée dans un tampon fixe puis envoyée en un seul write()*/
+    explicit ProtocolWriter(int output_fd = STDOUT_FILENO) : fd(output_fd) {}
+
+    void move(Move m)
+    {
+        /**"4TR\n"*/
+        append(m.text(), m.textLength());
+        buffer[length++] = '\n';
+    }
+
+    void result(Move last, int score_j1, int score_j2)
+    {
+        /**"RESULT <dernier coup> <score J1> <score J2>\n"*/
+        append("RESULT ", 7);
+        append(last.text(), last.textLength());
+        scores(score_j1, score_j2);
+    }
+
+    void resultLimit(int score_j1, int score_j2)
+    {
+        /**"RESULT LIMIT <score J1> <score J2>\n" (limite de 400 coups)*/
+        append("RESULT LIMIT", 12);
+        scores(score_j1, score_j2);
+    }
+
+    bool flush()
+    {
+        /**Envoie la réponse (write() partiels et EINTR repris), vide le tampon*/
+        size_t sent = 0;
+        while (sent < length)
+        {
+            ssize_t n = ::write(fd, buffer + sent, length - sent);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                length = 0;
+                return false;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        length = 0;
+        return true;
+    }
+
+private:
+    int fd;
+    char buffer[64]; // "16TR\nRESULT 16TR 96 96\n" au plus
+    size_t length = 0;
+
+    void append(const char *text, size_t n)
+    {
+        std::memcpy(buffer + length, text, n);
+        length += n;
+    }
+
+    void number(int value)
+    {
+        // Scores de 0 à 96
+        if (value >= 10)
+        {
+            buffer[length++] = static_cast<char>('0' + value / 10);
+        }
+        buffer[length++] = static_cast<char>('0' + value % 10);
+    }
+
+    void scores(int score_j1, int score_j2)
+    {
+        buffer[length++] = ' ';
+        number(score_j1);
+        buffer[length++] = ' ';
+        number(score_j2);
+        buffer[length++] = '\n';
+    }
+};
+
+#endif // PROTOCOL_H
@@ -0,0 +1,261 @@
+/**
+ * Génération de données d'auto-jeu pour l'entraînement de l'évaluation
+ * - Parties MinMaxBot contre lui-même, à profondeur fixe (--depth) et/ou budget de nœuds (--nodes):
+ *   le contenu ne dépend ni de la machine ni de la charge
+ * - Ouvertures aléatoires: --plies coups tirés au hasard (graine par partie), non enregistrés
+ * - Chaque position jouée est annotée du score et du coup de la recherche, et du résultat final
+ * - Un thread de jeu par cœur, chacun avec son bot et son bloc en cours: aucun verrou par coup
+ * - Blocs compressés (selfplay_data.h) confiés à un thread d'écriture; au plus --queue blocs
+ *   en attente, les threads de jeu attendent au-delà (mémoire bornée)
+ *
+ * Usage: selfplay --out selfplay.mself [--games 1000] [--threads N] [--depth 6] [--nodes N]
+ *                 [--plies 8] [--seed S] [--chunk 65536] [--queue 4] [--nnue fichier]
+ */
+
+#include "game_rules.h"
+#include "game_engine.h"
+#include "ai_algorithms.h"
+#include "playout.h"
+#include "notation.h"
+#include "nnue.h"
+#include "selfplay_data.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+struct SelfPlayConfig
+{
+    int games = 1000;
+    int max_depth = 6;
+    long nodes = 0; // 0: profondeur fixe seulement
+    int plies = 8;
+    uint64_t seed = 20250101;
+    uint32_t chunk_positions = 65536;
+    const NnueNetwork *network = nullptr;
+};
+
+struct SelfPlayProgress
+{
+    std::atomic<long> next_game{0};
+    std::atomic<long> games{0};
+    std::atomic<long> positions{0};
+    std::atomic<long> skipped{0}; // ouvertures terminales ou parties interrompues
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+static bool randomOpening(GameState &state, int plies, XorShiftRng &rng)
+{
+    /**Coups aléatoires depuis la position initiale; false si la partie est déjà finie*/
+    state = GameState();
+    for (int ply = 0; ply < plies && !state.isGameOver(); ply++)
+    {
+        uint32_t mask = Playout::legalMoveMask(state, state.current_player);
+        if (mask == 0)
+        {
+            return false;
+        }
+        Playout::applyFast(state, Playout::randomMove(mask, rng));
+    }
+    return !state.isGameOver() && Playout::legalMoveMask(state, state.current_player) != 0;
+}
+
+static void submitChunk(SelfPlayChunk &chunk, SelfPlayWriter &writer, SelfPlayProgress &progress)
+{
+    long positions = progress.positions += chunk.positionCount();
+    writer.submit(chunk.finish());
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - progress.start).count();
+    std::printf("parties %ld  positions %ld  %.0f positions/s  %.1f Mo écrits\n", progress.games.load(), positions,
+                seconds > 0 ? positions / seconds : 0.0, writer.bytesWritten() / 1e6);
+    std::fflush(stdout);
+}
+
+static void playGames(const SelfPlayConfig &config, SelfPlayWriter &writer, SelfPlayProgress &progress)
+{
+    /**Boucle d'un thread de jeu: parties prises au compteur partagé jusqu'à épuisement*/
+    MinMaxBot bot(1);
+    bot.max_depth = config.max_depth;
+    bot.node_limit = config.nodes;
+    bot.evaluator.network = config.network;
+    SelfPlayChunk chunk;
+
+    long game;
+    while ((game = progress.next_game++) < config.games)
+    {
+        // Graine par partie: le contenu d'une partie ne dépend pas du thread qui la joue
+        XorShiftRng rng(config.seed + 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(game + 1));
+        GameState state;
+        PackedPosition start;
+        if (!randomOpening(state, config.plies, rng) || !Notation::pack(state, start))
+        {
+            progress.skipped++;
+            continue;
+        }
+
+        chunk.beginGame(start);
+        GameEngine engine(&state);
+        bool interrupted = false;
+        while (!state.isGameOver())
+        {
+            int player = state.current_player;
+            Move move = bot.findBestMove(state, player, std::chrono::milliseconds(3600000));
+            if (!move.valid())
+            {
+                // Plus de coup pour le joueur au trait: fin de partie, comme dans GameManager
+                break;
+            }
+            // Aucune itération complète sans limite de temps: tous les coups perdent (score -infini)
+            double score = bot.stats.depth_reached > 0 ? bot.stats.score : -std::numeric_limits<double>::infinity();
+            chunk.addPly(move, bot.stats.depth_reached, score);
+            if (!engine.playMove(move))
+            {
+                interrupted = true;
+                break;
+            }
+        }
+
+        if (interrupted)
+        {
+            chunk.abortGame();
+            progress.skipped++;
+            continue;
+        }
+        chunk.endGame(state.getWinner());
+        progress.games++;
+
+        if (chunk.positionCount() >= config.chunk_positions)
+        {
+            submitChunk(chunk, writer, progress);
+        }
+    }
+
+    if (!chunk.empty())
+    {
+        submitChunk(chunk, writer, progress);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    SelfPlayConfig config;
+    std::string out_path = "selfplay.mself";
+    std::string nnue_path;
+    int threads = 0;
+    int queue = 4;
+    bool depth_given = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--out" && has_value)
+        {
+            out_path = argv[++i];
+        }
+        else if (arg == "--games" && has_value)
+        {
+            config.games = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--threads" && has_value)
+        {
+            threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--depth" && has_value)
+        {
+            config.max_depth = std::max(1, std::stoi(argv[++i]));
+            depth_given = true;
+        }
+        else if (arg == "--nodes" && has_value)
+        {
+            config.nodes = std::max(0L, std::stol(argv[++i]));
+        }
+        else if (arg == "--plies" && has_value)
+        {
+            config.plies = std::max(0, std::stoi(argv[++i]));
+        }
+        else if (arg == "--seed" && has_value)
+        {
+            config.seed = std::stoull(argv[++i]);
+        }
+        else if (arg == "--chunk" && has_value)
+        {
+            config.chunk_positions = static_cast<uint32_t>(std::max(1, std::stoi(argv[++i])));
+        }
+        else if (arg == "--queue" && has_value)
+        {
+            queue = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--nnue" && has_value)
+        {
+            nnue_path = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Usage: selfplay --out selfplay.mself [--games 1000] [--threads N] [--depth 6] [--nodes N]"
+                      << " [--plies 8] [--seed S] [--chunk 65536] [--queue 4] [--nnue fichier]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Budget de nœuds sans --depth: la profondeur n'est bornée que par le max de MinMaxBot
+    if (config.nodes > 0 && !depth_given)
+    {
+        config.max_depth = MinMaxBot().max_depth;
+    }
+
+    static NnueNetwork network;
+    if (!nnue_path.empty())
+    {
+        if (!network.load(nnue_path))
+        {
+            std::cerr << "Réseau illisible: " << nnue_path << std::endl;
+            return 1;
+        }
+        config.network = &network;
+    }
+
+    if (threads <= 0)
+    {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    SelfPlayWriter writer(static_cast<size_t>(queue));
+    if (!writer.open(out_path))
+    {
+        std::cerr << "Écriture impossible: " << out_path << std::endl;
+        return 1;
+    }
+
+    std::printf("%d parties, profondeur %d, nœuds %ld, ouverture %d coups, %d thread(s) -> %s\n", config.games,
+                config.max_depth, config.nodes, config.plies, threads, out_path.c_str());
+
+    SelfPlayProgress progress;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&]() { playGames(config, writer, progress); });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    bool ok = writer.close();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - progress.start).count();
+    std::printf("\n%ld parties, %ld positions (%ld parties écartées) en %.1f s, %.2f octets par position\n",
+                progress.games.load(), progress.positions.load(), progress.skipped.load(), seconds,
+                progress.positions > 0 ? static_cast<double>(writer.bytesWritten()) / progress.positions : 0.0);
+    if (!ok)
+    {
+        std::cerr << "Erreur d'écriture dans " << out_path << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,499 @@
+/**
+ * Données d'auto-jeu: positions annotées (score de recherche, meilleur coup, résultat)
+ * par blocs compressés, écrites par un thread dédié et relues par projection mémoire
+ *
+ * Fichier: en-tête de 8 octets ("MSELF" + version + 2 octets réservés), puis des blocs:
+ *     SelfPlayChunkHeader (16 octets)
+ *     parties: SelfPlayGameHeader (36 octets), puis pour chaque coup
+ *              code Move (1 octet), profondeur (1 octet), score (varint zigzag)
+ *
+ * Une position n'est pas stockée: le lecteur la reconstruit en rejouant les coups depuis
+ * la position de départ de la partie (après l'ouverture aléatoire). Une position annotée
+ * coûte ainsi 3 à 4 octets au lieu des 32 d'une PackedPosition.
+ * Le coup enregistré est celui que la recherche a retenu, et qui a été joué.
+ * Un bloc est écrit en un seul write() sur un fichier O_APPEND, avec sa somme de contrôle:
+ * un bloc abîmé est sauté, un bloc tronqué (arrêt en cours d'écriture) termine la lecture.
+ */
+
+#ifndef SELFPLAY_DATA_H
+#define SELFPLAY_DATA_H
+
+#include "game_rules.h"
+#include "game_engine.h"
+#include "move.h"
+#include "notation.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char SELFPLAY_MAGIC[6] = {'M', 'S', 'E', 'L', 'F', 1}; // magic + version
+
+// Scores saturés à ±SELFPLAY_SCORE_LIMIT (les fins de partie valent ±infini dans la recherche)
+constexpr int SELFPLAY_SCORE_LIMIT = 32767;
+
+#pragma pack(push, 1)
+struct SelfPlayChunkHeader
+{
+    uint32_t size;      // taille du bloc (en-tête compris)
+    uint32_t games;     // nombre de parties
+    uint32_t positions; // nombre de positions annotées
+    uint32_t checksum;  // FNV-1a des octets qui suivent l'en-tête
+};
+
+struct SelfPlayGameHeader
+{
+    PackedPosition start; // position après l'ouverture aléatoire
+    uint8_t winner;       // 1, 2 ou 0 (égalité)
+    uint8_t reserved;
+    uint16_t plies; // coups enregistrés
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SelfPlayChunkHeader) == 16, "SelfPlayChunkHeader: 16 octets");
+static_assert(sizeof(SelfPlayGameHeader) == 36, "SelfPlayGameHeader: 36 octets");
+
+inline uint32_t selfPlayChecksum(const uint8_t *data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+class SelfPlayChunk
+{
+public:
+    /**Bloc en construction (un par thread de jeu): parties ajoutées coup par coup*/
+    SelfPlayChunk() { clear(); }
+
+    void clear()
+    {
+        bytes.assign(sizeof(SelfPlayChunkHeader), 0);
+        games = 0;
+        positions = 0;
+        game_offset = 0;
+    }
+
+    uint32_t positionCount() const { return positions; }
+    bool empty() const { return games == 0; }
+
+    void beginGame(const PackedPosition &start)
+    {
+        game_offset = bytes.size();
+        game_positions = 0;
+        SelfPlayGameHeader header{};
+        header.start = start;
+        append(&header, sizeof(header));
+    }
+
+    void addPly(Move move, int depth, double score)
+    {
+        /**Coup retenu par la recherche, profondeur atteinte et score pour le joueur au trait*/
+        double clamped = std::max<double>(-SELFPLAY_SCORE_LIMIT, std::min<double>(SELFPLAY_SCORE_LIMIT, score));
+        int32_t value = static_cast<int32_t>(std::lround(clamped));
+        uint32_t zigzag = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+        bytes.push_back(move.code);
+        bytes.push_back(static_cast<uint8_t>(std::min(depth, 255)));
+        while (zigzag >= 0x80)
+        {
+            bytes.push_back(static_cast<uint8_t>(zigzag | 0x80));
+            zigzag >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(zigzag));
+        game_positions++;
+    }
+
+    void endGame(int winner)
+    {
+        SelfPlayGameHeader *header = reinterpret_cast<SelfPlayGameHeader *>(bytes.data() + game_offset);
+        header->winner = static_cast<uint8_t>(winner);
+        header->plies = static_cast<uint16_t>(game_positions);
+        games++;
+        positions += game_positions;
+    }
+
+    void abortGame()
+    {
+        /**Retire la partie en cours (partie interrompue: pas de résultat à annoter)*/
+        bytes.resize(game_offset);
+    }
+
+    std::vector<uint8_t> finish()
+    {
+        /**Complète l'en-tête et rend les octets du bloc; le bloc repart vide*/
+        SelfPlayChunkHeader header;
+        header.size = static_cast<uint32_t>(bytes.size());
+        header.games = games;
+        header.positions = positions;
+        header.checksum = selfPlayChecksum(bytes.data() + sizeof(header), bytes.size() - sizeof(header));
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::vector<uint8_t> out;
+        out.swap(bytes);
+        clear();
+        return out;
+    }
+
+private:
+    std::vector<uint8_t> bytes;
+    uint32_t games;
+    uint32_t positions;
+    uint32_t game_positions = 0;
+    size_t game_offset;
+
+    void append(const void *data, size_t size)
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        bytes.insert(bytes.end(), p, p + size);
+    }
+};
+
+class SelfPlayWriter
+{
+public:
+    /**
+    Écriture des blocs par un thread dédié: les threads de jeu ne touchent jamais au disque
+    Au plus max_pending blocs en attente: submit() bloque au-delà (mémoire bornée)
+    */
+    explicit SelfPlayWriter(size_t max_pending = 4) : capacity(max_pending > 0 ? max_pending : 1) {}
+    ~SelfPlayWriter() { close(); }
+
+    SelfPlayWriter(const SelfPlayWriter &) = delete;
+    SelfPlayWriter &operator=(const SelfPlayWriter &) = delete;
+
+    bool open(const std::string &path)
+    {
+        close();
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size == 0)
+        {
+            char file_header[8] = {};
+            std::memcpy(file_header, SELFPLAY_MAGIC, sizeof(SELFPLAY_MAGIC));
+            if (!writeAll(file_header, sizeof(file_header)))
+            {
+                ::close(fd);
+                fd = -1;
+                return false;
+            }
+        }
+        closing = false;
+        failed = false;
+        thread = std::thread([this]() { writerLoop(); });
+        return true;
+    }
+
+    void submit(std::vector<uint8_t> chunk)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this]() { return pending.size() < capacity; });
+        pending.push_back(std::move(chunk));
+        not_empty.notify_one();
+    }
+
+    bool close()
+    {
+        /**Écrit les blocs en attente puis ferme; false si une écriture a échoué*/
+        if (thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closing = true;
+            }
+            not_empty.notify_all();
+            thread.join();
+        }
+        if (fd >= 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+        return !failed;
+    }
+
+    uint64_t bytesWritten() const { return written; }
+
+private:
+    int fd = -1;
+    size_t capacity;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<std::vector<uint8_t>> pending;
+    bool closing = false;
+    bool failed = false;
+    std::atomic<uint64_t> written{0}; // lu par les threads de jeu pendant l'écriture
+
+    bool writeAll(const void *data, size_t size)
+    {
+        const char *p = static_cast<const char *>(data);
+        size_t sent = 0;
+        while (sent < size)
+        {
+            ssize_t n = ::write(fd, p + sent, size - sent);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                return false;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    void writerLoop()
+    {
+        while (true)
+        {
+            std::vector<uint8_t> chunk;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                not_empty.wait(lock, [this]() { return closing || !pending.empty(); });
+                if (pending.empty())
+                {
+                    return;
+                }
+                chunk = std::move(pending.front());
+                pending.pop_front();
+            }
+            not_full.notify_one();
+
+            if (!writeAll(chunk.data(), chunk.size()))
+            {
+                failed = true;
+            }
+            written += chunk.size();
+        }
+    }
+};
+
+struct SelfPlayPosition
+{
+    GameState state; // position avant le coup
+    Move best_move;  // coup retenu par la recherche
+    int score;       // score de la recherche pour le joueur au trait
+    int depth;       // profondeur complète atteinte
+    int winner;      // résultat de la partie: 1, 2 ou 0 (égalité)
+    long game;       // numéro de la partie dans le fichier (à partir de 0)
+};
+
+class SelfPlayReader
+{
+public:
+    /**Lecteur par mmap: positions reconstruites en rejouant chaque partie, sans copie du fichier*/
+    SelfPlayReader() = default;
+    explicit SelfPlayReader(const std::string &path) { open(path); }
+    ~SelfPlayReader() { close(); }
+
+    SelfPlayReader(const SelfPlayReader &) = delete;
+    SelfPlayReader &operator=(const SelfPlayReader &) = delete;
+
+    bool open(const std::string &path)
+    {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < 8)
+        {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(st.st_size);
+        void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED)
+        {
+            size = 0;
+            return false;
+        }
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        data = static_cast<const uint8_t *>(mapped);
+        if (std::memcmp(data, SELFPLAY_MAGIC, sizeof(SELFPLAY_MAGIC)) != 0)
+        {
+            close();
+            return false;
+        }
+        rewind();
+        return true;
+    }
+
+    void close()
+    {
+        if (data)
+        {
+            munmap(const_cast<uint8_t *>(data), size);
+            data = nullptr;
+        }
+        size = 0;
+        offset = 0;
+        cursor = chunk_end = nullptr;
+        plies_left = 0;
+    }
+
+    void rewind()
+    {
+        offset = 8;
+        cursor = chunk_end = nullptr;
+        plies_left = 0;
+        game = -1;
+    }
+
+    bool next(SelfPlayPosition &position)
+    {
+        /**Position annotée suivante; false à la fin du fichier ou sur un bloc tronqué*/
+        while (true)
+        {
+            while (plies_left == 0)
+            {
+                if (!nextGame())
+                {
+                    return false;
+                }
+            }
+
+            uint32_t zigzag;
+            if (chunk_end - cursor < 3 || !readVarint(cursor + 2, zigzag))
+            {
+                cursor = chunk_end; // bloc incohérent: reste du bloc abandonné
+                plies_left = 0;
+                continue;
+            }
+            position.state = state;
+            position.best_move = Move(cursor[0]);
+            position.depth = cursor[1];
+            position.score = static_cast<int>(zigzag >> 1) ^ -static_cast<int>(zigzag & 1);
+            position.winner = winner;
+            position.game = game;
+            cursor = varint_end;
+            plies_left--;
+
+            GameEngine engine(&state);
+            if (!engine.playMove(position.best_move))
+            {
+                skipGame();
+            }
+            return true;
+        }
+    }
+
+private:
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+    const uint8_t *cursor = nullptr;
+    const uint8_t *chunk_end = nullptr;
+    const uint8_t *varint_end = nullptr;
+    GameState state;
+    int plies_left = 0;
+    int winner = 0;
+    long game = -1;
+
+    bool nextChunk()
+    {
+        while (data && offset + sizeof(SelfPlayChunkHeader) <= size)
+        {
+            SelfPlayChunkHeader header;
+            std::memcpy(&header, data + offset, sizeof(header));
+            if (header.size < sizeof(header) || offset + header.size > size)
+            {
+                return false;
+            }
+            const uint8_t *payload = data + offset + sizeof(header);
+            size_t payload_size = header.size - sizeof(header);
+            offset += header.size;
+            if (selfPlayChecksum(payload, payload_size) == header.checksum)
+            {
+                cursor = payload;
+                chunk_end = payload + payload_size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool nextGame()
+    {
+        if (cursor == chunk_end && !nextChunk())
+        {
+            return false;
+        }
+        if (static_cast<size_t>(chunk_end - cursor) < sizeof(SelfPlayGameHeader))
+        {
+            cursor = chunk_end;
+            return true; // reste du bloc inexploitable: bloc suivant au prochain tour
+        }
+        SelfPlayGameHeader header;
+        std::memcpy(&header, cursor, sizeof(header));
+        cursor += sizeof(header);
+        game++;
+        winner = header.winner;
+        plies_left = header.plies;
+        if (!Notation::unpack(header.start, state))
+        {
+            skipGame();
+        }
+        return true;
+    }
+
+    void skipGame()
+    {
+        // Coups restants de la partie lus sans être rejoués
+        while (plies_left > 0)
+        {
+            uint32_t ignored;
+            if (chunk_end - cursor < 3 || !readVarint(cursor + 2, ignored))
+            {
+                cursor = chunk_end;
+                break;
+            }
+            cursor = varint_end;
+            plies_left--;
+        }
+        plies_left = 0;
+    }
+
+    bool readVarint(const uint8_t *p, uint32_t &value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 35 && p < chunk_end; shift += 7)
+        {
+            uint8_t byte = *p++;
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                varint_end = p;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif // SELFPLAY_DATA_H
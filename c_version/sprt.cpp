@@ -0,0 +1,314 @@
+/**
+ * Test séquentiel (SPRT) entre deux configurations de MinMaxBot
+ * - Parties en parallèle sur un pool de threads
+ * - Chaque ouverture est jouée deux fois, camps inversés (paire de parties)
+ * - GSPRT sur les scores des paires (modèle pentanomial), bornes Elo [elo0, elo1]
+ * - Arrêt dès que H0 (elo <= elo0) ou H1 (elo >= elo1) est acceptée
+ *
+ * Usage: sprt --a "depth=20,time=100" --b "depth=20,time=50"
+ *             [--elo0 0] [--elo1 5] [--alpha 0.05] [--beta 0.05]
+ *             [--threads N] [--max-games N] [--plies N] [--seed S]
+ */
+
+#include "game_rules.h"
+#include "game_engine.h"
+#include "ai_algorithms.h"
+#include "tournament.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+
+struct EngineConfig
+{
+    int max_depth = 20;
+    int time_ms = 100;
+
+    static EngineConfig parse(const std::string &spec)
+    {
+        /**Format "clé=valeur,clé=valeur" (clés: depth, time)*/
+        EngineConfig config;
+        std::stringstream ss(spec);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            size_t eq = item.find('=');
+            if (eq == std::string::npos)
+            {
+                continue;
+            }
+            std::string key = item.substr(0, eq);
+            int value = std::stoi(item.substr(eq + 1));
+            if (key == "depth")
+            {
+                config.max_depth = value;
+            }
+            else if (key == "time")
+            {
+                config.time_ms = value;
+            }
+            else
+            {
+                std::cerr << "Option inconnue ignorée: " << key << std::endl;
+            }
+        }
+        return config;
+    }
+
+    std::string toString() const
+    {
+        return "depth=" + std::to_string(max_depth) + ",time=" + std::to_string(time_ms);
+    }
+};
+
+static double playGame(const EngineConfig &a, const EngineConfig &b, const GameState &opening, bool a_is_player1)
+{
+    /**Joue une partie depuis l'ouverture, retourne le score de A (1, 0.5 ou 0)*/
+    MinMaxBot bot_a(1);
+    MinMaxBot bot_b(1);
+    bot_a.max_depth = a.max_depth;
+    bot_b.max_depth = b.max_depth;
+
+    GameState state = opening;
+    GameEngine engine(&state);
+    int a_player = a_is_player1 ? 1 : 2;
+
+    while (!state.isGameOver())
+    {
+        int player = state.current_player;
+        bool a_to_move = player == a_player;
+        MinMaxBot &bot = a_to_move ? bot_a : bot_b;
+        const EngineConfig &config = a_to_move ? a : b;
+
+        Move move = bot.findBestMove(state, player, std::chrono::milliseconds(config.time_ms));
+        if (!move.valid() || !engine.playMove(move))
+        {
+            break;
+        }
+    }
+
+    int winner = state.getWinner();
+    return winner == 0 ? 0.5 : (winner == a_player ? 1.0 : 0.0);
+}
+
+class Sprt
+{
+public:
+    /**
+    GSPRT pentanomial: chaque paire donne un score moyen x dans {0, 1/4, 1/2, 3/4, 1}
+    LLR ≈ n (s1 - s0) (2 x̄ - s0 - s1) / (2 var(x)), s = score attendu pour un écart Elo
+    */
+    double elo0, elo1, lower, upper;
+    long pentanomial[5] = {0, 0, 0, 0, 0}; // paires par total de points (0 à 2 par demi-points)
+    long wins = 0, draws = 0, losses = 0;
+
+    Sprt(double e0, double e1, double alpha, double beta)
+        : elo0(e0), elo1(e1), lower(std::log(beta / (1 - alpha))), upper(std::log((1 - beta) / alpha)) {}
+
+    static double expectedScore(double elo)
+    {
+        return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+    }
+
+    void addPair(double first, double second)
+    {
+        for (double s : {first, second})
+        {
+            if (s == 1.0)
+            {
+                wins++;
+            }
+            else if (s == 0.5)
+            {
+                draws++;
+            }
+            else
+            {
+                losses++;
+            }
+        }
+        pentanomial[static_cast<int>(std::lround(2 * (first + second)))]++;
+    }
+
+    long pairs() const
+    {
+        long n = 0;
+        for (long c : pentanomial)
+        {
+            n += c;
+        }
+        return n;
+    }
+
+    double meanScore() const
+    {
+        long n = pairs();
+        double sum = 0;
+        for (int k = 0; k < 5; k++)
+        {
+            sum += pentanomial[k] * (k / 4.0);
+        }
+        return n > 0 ? sum / n : 0.5;
+    }
+
+    double llr() const
+    {
+        long n = pairs();
+        if (n < 2)
+        {
+            return 0.0;
+        }
+        double mean = meanScore();
+        double var = 0;
+        for (int k = 0; k < 5; k++)
+        {
+            double d = k / 4.0 - mean;
+            var += pentanomial[k] * d * d;
+        }
+        var /= n;
+        if (var <= 0)
+        {
+            return 0.0;
+        }
+        double s0 = expectedScore(elo0);
+        double s1 = expectedScore(elo1);
+        return n * (s1 - s0) * (2 * mean - s0 - s1) / (2 * var);
+    }
+
+    int decision() const
+    {
+        /**1: H1 acceptée, -1: H0 acceptée, 0: continuer*/
+        double value = llr();
+        return value >= upper ? 1 : (value <= lower ? -1 : 0);
+    }
+
+    double eloEstimate() const
+    {
+        double s = std::min(std::max(meanScore(), 1e-6), 1 - 1e-6);
+        return -400.0 * std::log10(1.0 / s - 1.0);
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    EngineConfig config_a, config_b;
+    double elo0 = 0, elo1 = 5, alpha = 0.05, beta = 0.05;
+    int threads = 0;
+    int max_games = 20000;
+    int plies = 6;
+    uint64_t seed = 20250101;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--a" && has_value)
+        {
+            config_a = EngineConfig::parse(argv[++i]);
+        }
+        else if (arg == "--b" && has_value)
+        {
+            config_b = EngineConfig::parse(argv[++i]);
+        }
+        else if (arg == "--elo0" && has_value)
+        {
+            elo0 = std::stod(argv[++i]);
+        }
+        else if (arg == "--elo1" && has_value)
+        {
+            elo1 = std::stod(argv[++i]);
+        }
+        else if (arg == "--alpha" && has_value)
+        {
+            alpha = std::stod(argv[++i]);
+        }
+        else if (arg == "--beta" && has_value)
+        {
+            beta = std::stod(argv[++i]);
+        }
+        else if (arg == "--threads" && has_value)
+        {
+            threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--max-games" && has_value)
+        {
+            max_games = std::max(2, std::stoi(argv[++i]));
+        }
+        else if (arg == "--plies" && has_value)
+        {
+            plies = std::max(0, std::stoi(argv[++i]));
+        }
+        else if (arg == "--seed" && has_value)
+        {
+            seed = std::stoull(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "Usage: sprt --a \"depth=20,time=100\" --b \"depth=20,time=50\" [--elo0 0] [--elo1 5]"
+                      << " [--alpha 0.05] [--beta 0.05] [--threads N] [--max-games N] [--plies N] [--seed S]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    int max_pairs = max_games / 2;
+    std::vector<GameState> openings = Tournament::generateOpenings(max_pairs, plies, seed);
+    if (openings.empty())
+    {
+        openings.push_back(GameState());
+    }
+
+    Sprt sprt(elo0, elo1, alpha, beta);
+    std::mutex result_mutex;
+    std::atomic<bool> stop(false);
+    ThreadPool pool(threads);
+
+    std::printf("A: %s\nB: %s\nSPRT elo0=%.1f elo1=%.1f alpha=%.3f beta=%.3f bornes LLR [%.2f, %.2f], %d thread(s)\n",
+                config_a.toString().c_str(), config_b.toString().c_str(), elo0, elo1, alpha, beta, sprt.lower,
+                sprt.upper, pool.size());
+
+    for (int p = 0; p < max_pairs; p++)
+    {
+        pool.submit([&, p]()
+        {
+            if (stop)
+            {
+                return;
+            }
+            const GameState &opening = openings[p % openings.size()];
+            double first = playGame(config_a, config_b, opening, true);
+            double second = playGame(config_a, config_b, opening, false);
+
+            std::lock_guard<std::mutex> lock(result_mutex);
+            if (stop)
+            {
+                return;
+            }
+            sprt.addPair(first, second);
+            if (sprt.pairs() % 10 == 0 || sprt.decision() != 0)
+            {
+                std::printf("parties %ld  V-N-D %ld-%ld-%ld  Elo %+.1f  LLR %.2f\n", 2 * sprt.pairs(), sprt.wins,
+                            sprt.draws, sprt.losses, sprt.eloEstimate(), sprt.llr());
+                std::fflush(stdout);
+            }
+            if (sprt.decision() != 0)
+            {
+                stop = true;
+            }
+        });
+    }
+    pool.wait();
+
+    int decision = sprt.decision();
+    std::printf("\nRésultat après %ld parties: %s (LLR %.2f, Elo %+.1f)\n", 2 * sprt.pairs(),
+                decision > 0 ? "H1 acceptée, A est plus fort" : decision < 0 ? "H0 acceptée, A n'est pas plus fort"
+                                                                          : "non concluant (limite de parties)",
+                sprt.llr(), sprt.eloEstimate());
+    return decision > 0 ? 0 : (decision < 0 ? 2 : 3);
+}
@@ -0,0 +1,100 @@
+/**
+ * Pool de threads minimal pour les traitements par lots (tournois, analyses)
+ * - Nombre fixe de threads, file de tâches FIFO
+ * - wait() attend la fin de toutes les tâches soumises
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads = 0) {
+        /**threads <= 0: un thread par cœur*/
+        if (threads <= 0) {
+            threads = static_cast<int>(std::thread::hardware_concurrency());
+        }
+        if (threads <= 0) {
+            threads = 1;
+        }
+        for (int i = 0; i < threads; i++) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        task_ready.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const {
+        return static_cast<int>(workers.size());
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push(std::move(task));
+            pending++;
+        }
+        task_ready.notify_one();
+    }
+
+    void wait() {
+        /**Bloque jusqu'à ce que toutes les tâches soumises soient terminées*/
+        std::unique_lock<std::mutex> lock(mutex);
+        all_done.wait(lock, [this]() { return pending == 0; });
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable task_ready;
+    std::condition_variable all_done;
+    size_t pending = 0;
+    bool stopping = false;
+
+    void workerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                task_ready.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending--;
+                if (pending == 0) {
+                    all_done.notify_all();
+                }
+            }
+        }
+    }
+};
+
+#endif // THREAD_POOL_H
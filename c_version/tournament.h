@@ -0,0 +1,291 @@
+/**
+ * Tournoi entre IA - parties en parallèle et estimation Elo
+ * - Chaque partie part d'une ouverture tirée au hasard (graine fixe)
+ * - Chaque ouverture est jouée deux fois, couleurs inversées
+ * - Les parties tournent sur un pool de threads (une partie par tâche)
+ * - Elo par maximum de vraisemblance (Bradley-Terry, nulle = demi-point),
+ *   barres d'erreur à 95%, et tableau croisé des résultats
+ */
+
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include "game_manager.h"
+#include "playout.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+struct TournamentPlayer {
+    std::string name;
+    std::string type;                  // algorithme ("bfs", "minimax", ...)
+    std::map<std::string, int> config; // {"depth", n}
+};
+
+struct TournamentGame {
+    int player1;  // indices dans Tournament::players
+    int player2;
+    int opening;
+    int winner;   // 1, 2 ou 0 (égalité)
+    int player1_captured;
+    int player2_captured;
+};
+
+struct EloEstimate {
+    double elo;
+    double error; // demi-largeur de l'intervalle à 95%
+    double score; // points marqués
+    int games;
+};
+
+class Tournament {
+public:
+    /**Gère un tournoi entre plusieurs IA*/
+    std::vector<std::map<std::string, std::string>> results;
+    std::vector<TournamentPlayer> players;
+    std::vector<TournamentGame> games;
+    GameLogWriter* game_log = nullptr; // chaque partie y est ajoutée si défini
+
+    void playMatch(const std::string& player1_type, const std::map<std::string, int>& player1_config,
+                   const std::string& player2_type, const std::map<std::string, int>& player2_config,
+                   bool verbose = false, const GameState* opening = nullptr) {
+        /**Joue un match entre deux joueurs (depuis l'ouverture si fournie)*/
+        GameManager manager(player1_type, player1_config, player2_type, player2_config);
+        if (opening) {
+            manager.state = *opening;
+        }
+        int winner = manager.playGame(verbose);
+
+        GameStats stats = manager.getGameStats();
+
+        std::map<std::string, std::string> match_result;
+        match_result["player1"] = player1_type;
+        match_result["player2"] = player2_type;
+        match_result["winner"] = std::to_string(winner);
+        match_result["player1_captured"] = std::to_string(stats.player1_captured);
+        match_result["player2_captured"] = std::to_string(stats.player2_captured);
+
+        results.push_back(match_result);
+    }
+
+    static std::vector<GameState> generateOpenings(int count, int plies, uint64_t seed) {
+        /**
+        Positions de départ distinctes: `plies` coups aléatoires depuis la position initiale
+        Les positions déjà terminées ou en double sont écartées
+        */
+        std::vector<GameState> openings;
+        XorShiftRng rng(seed);
+        int attempts = 0;
+        while (static_cast<int>(openings.size()) < count && attempts < count * 100) {
+            attempts++;
+            GameState state;
+            for (int ply = 0; ply < plies && !state.isGameOver(); ply++) {
+                uint32_t mask = Playout::legalMoveMask(state, state.current_player);
+                if (mask == 0) {
+                    break;
+                }
+                Playout::applyFast(state, Playout::randomMove(mask, rng));
+            }
+            if (state.isGameOver() || Playout::legalMoveMask(state, state.current_player) == 0) {
+                continue;
+            }
+            if (std::find(openings.begin(), openings.end(), state) == openings.end()) {
+                openings.push_back(state);
+            }
+        }
+        return openings;
+    }
+
+    void run(const std::vector<TournamentPlayer>& entrants, const std::vector<GameState>& openings,
+             int threads = 0, bool show_progress = true) {
+        /**
+        Toutes les paires, chaque ouverture jouée deux fois (couleurs inversées)
+        Les parties sont indépendantes: chacune a son GameManager et ses IA
+        */
+        players = entrants;
+        games.clear();
+        for (int i = 0; i < static_cast<int>(players.size()); i++) {
+            for (int j = i + 1; j < static_cast<int>(players.size()); j++) {
+                for (int o = 0; o < static_cast<int>(openings.size()); o++) {
+                    games.push_back({i, j, o, 0, 0, 0});
+                    games.push_back({j, i, o, 0, 0, 0});
+                }
+            }
+        }
+
+        ThreadPool pool(threads);
+        std::atomic<int> finished(0);
+        std::mutex print_mutex;
+        int total = static_cast<int>(games.size());
+        int step = std::max(1, total / 20);
+
+        for (TournamentGame& game : games) {
+            pool.submit([&, &game = game]() {
+                const TournamentPlayer& p1 = players[game.player1];
+                const TournamentPlayer& p2 = players[game.player2];
+                GameManager manager(p1.type, p1.config, p2.type, p2.config);
+                manager.state = openings[game.opening];
+                manager.game_log = game_log;
+                manager.log_record.player1 = p1.name;
+                manager.log_record.player2 = p2.name;
+                game.winner = manager.playGame(false);
+                game.player1_captured = manager.state.captured_seeds[1];
+                game.player2_captured = manager.state.captured_seeds[2];
+
+                int done = ++finished;
+                if (show_progress && (done % step == 0 || done == total)) {
+                    std::lock_guard<std::mutex> lock(print_mutex);
+                    std::cout << "  " << done << "/" << total << " parties jouées" << std::endl;
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    std::vector<EloEstimate> estimateElo() const {
+        /**
+        Elo relatifs (moyenne 0) par maximum de vraisemblance de Bradley-Terry
+        - Itérations MM: gamma_i = points_i / somme_j n_ij / (gamma_i + gamma_j)
+        - Une nulle virtuelle par paire évite les Elo infinis (joueur à 0% ou 100%)
+        - Erreur: inverse de l'information de Fisher (diagonale), intervalle à 95%
+        */
+        int n = static_cast<int>(players.size());
+        std::vector<std::vector<double>> points(n, std::vector<double>(n, 0.0));
+        std::vector<std::vector<double>> played(n, std::vector<double>(n, 0.0));
+        for (const TournamentGame& game : games) {
+            double s1 = (game.winner == 1) ? 1.0 : (game.winner == 0) ? 0.5 : 0.0;
+            points[game.player1][game.player2] += s1;
+            points[game.player2][game.player1] += 1.0 - s1;
+            played[game.player1][game.player2] += 1.0;
+            played[game.player2][game.player1] += 1.0;
+        }
+
+        std::vector<EloEstimate> estimates(n, {0.0, 0.0, 0.0, 0});
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                estimates[i].score += points[i][j];
+                estimates[i].games += static_cast<int>(played[i][j]);
+                if (i != j && played[i][j] > 0) {
+                    points[i][j] += 0.5;
+                    played[i][j] += 1.0;
+                }
+            }
+        }
+
+        std::vector<double> gamma(n, 1.0);
+        for (int iter = 0; iter < 1000; iter++) {
+            double max_change = 0.0;
+            for (int i = 0; i < n; i++) {
+                double wins = 0.0;
+                double denom = 0.0;
+                for (int j = 0; j < n; j++) {
+                    if (played[i][j] > 0) {
+                        wins += points[i][j];
+                        denom += played[i][j] / (gamma[i] + gamma[j]);
+                    }
+                }
+                if (denom > 0) {
+                    double updated = wins / denom;
+                    max_change = std::max(max_change, std::fabs(std::log(updated / gamma[i])));
+                    gamma[i] = updated;
+                }
+            }
+
+            // Normalisation: moyenne géométrique 1 (Elo moyen 0)
+            double log_mean = 0.0;
+            for (double g : gamma) {
+                log_mean += std::log(g);
+            }
+            log_mean /= n;
+            for (double& g : gamma) {
+                g /= std::exp(log_mean);
+            }
+
+            if (max_change < 1e-9) {
+                break;
+            }
+        }
+
+        const double elo_per_nat = 400.0 / std::log(10.0);
+        for (int i = 0; i < n; i++) {
+            double information = 0.0;
+            for (int j = 0; j < n; j++) {
+                if (played[i][j] > 0) {
+                    double p = gamma[i] / (gamma[i] + gamma[j]);
+                    information += played[i][j] * p * (1.0 - p);
+                }
+            }
+            estimates[i].elo = elo_per_nat * std::log(gamma[i]);
+            estimates[i].error = information > 0 ? 1.96 * elo_per_nat / std::sqrt(information) : 0.0;
+        }
+        return estimates;
+    }
+
+    void printResults() {
+        /**Affiche le classement Elo et le tableau croisé du tournoi*/
+        if (players.empty()) {
+            return;
+        }
+
+        std::vector<EloEstimate> elo = estimateElo();
+        std::vector<int> order(players.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = static_cast<int>(i);
+        }
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return elo[a].elo > elo[b].elo; });
+
+        char line[256];
+        std::cout << "\n" << std::string(80, '=') << std::endl;
+        std::cout << "CLASSEMENT (" << games.size() << " parties)" << std::endl;
+        std::cout << std::string(80, '=') << std::endl;
+        std::snprintf(line, sizeof(line), "%-4s %-14s %8s %8s %10s %7s", "#", "IA", "Elo", "+/-", "Points", "Score");
+        std::cout << line << std::endl;
+        for (size_t rank = 0; rank < order.size(); rank++) {
+            const EloEstimate& e = elo[order[rank]];
+            std::snprintf(line, sizeof(line), "%-4zu %-14s %8.0f %8.0f %10.1f %6.1f%%", rank + 1,
+                          players[order[rank]].name.c_str(), e.elo, e.error,
+                          e.score, e.games > 0 ? 100.0 * e.score / e.games : 0.0);
+            std::cout << line << std::endl;
+        }
+
+        // Tableau croisé: points de la ligne contre la colonne
+        std::vector<std::vector<double>> points(players.size(), std::vector<double>(players.size(), 0.0));
+        std::vector<std::vector<int>> played(players.size(), std::vector<int>(players.size(), 0));
+        for (const TournamentGame& game : games) {
+            double s1 = (game.winner == 1) ? 1.0 : (game.winner == 0) ? 0.5 : 0.0;
+            points[game.player1][game.player2] += s1;
+            points[game.player2][game.player1] += 1.0 - s1;
+            played[game.player1][game.player2]++;
+            played[game.player2][game.player1]++;
+        }
+
+        std::cout << "\nTableau croisé (points / parties)" << std::endl;
+        std::snprintf(line, sizeof(line), "%-14s", "");
+        std::cout << line;
+        for (int j : order) {
+            std::snprintf(line, sizeof(line), " %12.12s", players[j].name.c_str());
+            std::cout << line;
+        }
+        std::cout << std::endl;
+        for (int i : order) {
+            std::snprintf(line, sizeof(line), "%-14.14s", players[i].name.c_str());
+            std::cout << line;
+            for (int j : order) {
+                if (i == j) {
+                    std::snprintf(line, sizeof(line), " %12s", "-");
+                } else {
+                    std::snprintf(line, sizeof(line), " %7.1f/%-4d", points[i][j], played[i][j]);
+                }
+                std::cout << line;
+            }
+            std::cout << std::endl;
+        }
+    }
+};
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,658 @@
+/**
+ * Ajustement des poids de l'évaluation (méthode de Texel)
+ * - Positions étiquetées lues dans des journaux de parties (game_log.h) ou des fichiers
+ *   de selfplay (selfplay_data.h): chaque position d'une partie reçoit le résultat final
+ *   (1, 0.5 ou 0 pour le joueur 1)
+ * - Modèle: P(victoire du joueur 1) = sigmoid(w · f), f = Evaluator::features(position, 1)
+ * - Descente de gradient (Adam) sur la perte logistique, gradient calculé en parallèle
+ * - Validation sur une partie sur dix (jamais vue pendant l'ajustement)
+ * - Écrit eval_weights.h: poids entiers, EVAL_CAPTURED ramené à --anchor
+ * - Avec --nnue: entraîne à la place le réseau de nnue.h (mini-lots, Adam) et écrit
+ *   ses poids quantifiés
+ *
+ * Usage: tune_eval games.mlog [autres.mlog ...] [--out eval_weights.h] [--iterations 1000]
+ *                  [--rate 0.01] [--threads N] [--anchor 100] [--skip-plies 4]
+ *        tune_eval games.mlog [...] --nnue mancala.nnue [--epochs 20] [--rate 0.001]
+ */
+
+#include "game_rules.h"
+#include "game_engine.h"
+#include "ai_algorithms.h"
+#include "game_log.h"
+#include "nnue.h"
+#include "selfplay_data.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+
+static const char *const FEATURE_NAMES[] = {"EVAL_CAPTURED", "EVAL_BOARD", "EVAL_VULNERABLE",
+                                            "EVAL_EMPTY", "EVAL_TRANSPARENT", "EVAL_TRANSPARENT_HOLES",
+                                            "EVAL_MOBILITY", "EVAL_NEAR_WIN", "EVAL_DRAW_LINE"};
+static_assert(sizeof(FEATURE_NAMES) / sizeof(FEATURE_NAMES[0]) == EVAL_FEATURE_COUNT, "un nom par caractéristique");
+
+struct Dataset
+{
+    /**Caractéristiques rangées position par position (int8: toutes tiennent dans [-96, 96])*/
+    std::vector<int8_t> features;
+    std::vector<uint8_t> labels; // résultat pour le joueur 1 en demi-points: 0, 1 ou 2
+
+    // Entrées actives du réseau (--nnue): position k = inputs[offsets[k], offsets[k + 1])
+    bool keep_inputs = false;
+    std::vector<uint16_t> inputs;
+    std::vector<uint32_t> offsets{0};
+
+    size_t size() const { return labels.size(); }
+
+    void add(const GameState &state, int result_halves)
+    {
+        int f[EVAL_FEATURE_COUNT];
+        Evaluator::features(state, 1, f);
+        for (int k = 0; k < EVAL_FEATURE_COUNT; k++)
+        {
+            features.push_back(static_cast<int8_t>(f[k]));
+        }
+        labels.push_back(static_cast<uint8_t>(result_halves));
+
+        if (keep_inputs)
+        {
+            int active[NnueNetwork::MAX_ACTIVE];
+            int n = NnueNetwork::activeInputs(state, active);
+            inputs.insert(inputs.end(), active, active + n);
+            offsets.push_back(static_cast<uint32_t>(inputs.size()));
+        }
+    }
+};
+
+static void loadSelfPlay(SelfPlayReader &reader, int skip_plies, Dataset &train, Dataset &validation, long &games)
+{
+    /**Positions d'un fichier de selfplay, étiquetées comme celles des journaux*/
+    SelfPlayPosition position;
+    long base = games;
+    while (reader.next(position))
+    {
+        games = base + position.game + 1;
+        if (position.state.move_count < skip_plies)
+        {
+            continue;
+        }
+        int result = position.winner == 1 ? 2 : (position.winner == 2 ? 0 : 1);
+        Dataset &target = ((base + position.game) % 10 == 9) ? validation : train;
+        target.add(position.state, result);
+    }
+}
+
+static bool loadGames(const std::string &path, int skip_plies, Dataset &train, Dataset &validation, long &games)
+{
+    /**Rejoue chaque partie du journal et ajoute ses positions (une partie sur dix en validation)*/
+    SelfPlayReader selfplay;
+    if (selfplay.open(path))
+    {
+        loadSelfPlay(selfplay, skip_plies, train, validation, games);
+        return true;
+    }
+
+    GameLogReader reader;
+    if (!reader.open(path))
+    {
+        std::cerr << "Journal illisible: " << path << std::endl;
+        return false;
+    }
+
+    GameLogView game;
+    while (reader.next(game))
+    {
+        GameState state;
+        if (!game.startPosition(state))
+        {
+            continue;
+        }
+        int winner = game.header->winner;
+        int result = winner == 1 ? 2 : (winner == 2 ? 0 : 1);
+        Dataset &target = (games % 10 == 9) ? validation : train;
+        games++;
+
+        GameEngine engine(&state);
+        for (int i = 0; i < game.moveCount(); i++)
+        {
+            if (state.isGameOver())
+            {
+                break;
+            }
+            if (i >= skip_plies)
+            {
+                target.add(state, result);
+            }
+            if (!engine.playMove(game.move(i)))
+            {
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+class Tuner
+{
+public:
+    /**Perte logistique moyenne et son gradient, par blocs de positions sur le pool*/
+    Tuner(const Dataset &d, ThreadPool &p) : data(d), pool(p) {}
+
+    double loss(const double *w, double *gradient) const
+    {
+        int blocks = std::max(1, pool.size() * 4);
+        size_t n = data.size();
+        std::vector<double> partial_loss(blocks, 0.0);
+        std::vector<double> partial_gradient(static_cast<size_t>(blocks) * EVAL_FEATURE_COUNT, 0.0);
+
+        for (int b = 0; b < blocks; b++)
+        {
+            pool.submit([&, b]()
+            {
+                size_t begin = n * b / blocks;
+                size_t end = n * (b + 1) / blocks;
+                double block_loss = 0.0;
+                double g[EVAL_FEATURE_COUNT] = {};
+                for (size_t i = begin; i < end; i++)
+                {
+                    const int8_t *f = &data.features[i * EVAL_FEATURE_COUNT];
+                    double z = 0.0;
+                    for (int k = 0; k < EVAL_FEATURE_COUNT; k++)
+                    {
+                        z += w[k] * f[k];
+                    }
+                    double y = data.labels[i] * 0.5;
+                    double p = 1.0 / (1.0 + std::exp(-z));
+                    // -[y log p + (1 - y) log(1 - p)], écrit pour rester stable quand |z| est grand
+                    block_loss += std::max(z, 0.0) - z * y + std::log1p(std::exp(-std::fabs(z)));
+                    double error = p - y;
+                    for (int k = 0; k < EVAL_FEATURE_COUNT; k++)
+                    {
+                        g[k] += error * f[k];
+                    }
+                }
+                partial_loss[b] = block_loss;
+                std::copy(g, g + EVAL_FEATURE_COUNT, &partial_gradient[static_cast<size_t>(b) * EVAL_FEATURE_COUNT]);
+            });
+        }
+        pool.wait();
+
+        double total = 0.0;
+        for (int k = 0; gradient && k < EVAL_FEATURE_COUNT; k++)
+        {
+            gradient[k] = 0.0;
+        }
+        for (int b = 0; b < blocks; b++)
+        {
+            total += partial_loss[b];
+            for (int k = 0; gradient && k < EVAL_FEATURE_COUNT; k++)
+            {
+                gradient[k] += partial_gradient[static_cast<size_t>(b) * EVAL_FEATURE_COUNT + k] / n;
+            }
+        }
+        return total / n;
+    }
+
+    double scaledLoss(const int *weights, double &best_scale) const
+    {
+        /**Perte de poids entiers à l'échelle logistique la plus favorable (recherche par section dorée)*/
+        double w[EVAL_FEATURE_COUNT];
+        auto at = [&](double log_scale)
+        {
+            for (int k = 0; k < EVAL_FEATURE_COUNT; k++)
+            {
+                w[k] = weights[k] * std::exp(log_scale);
+            }
+            return loss(w, nullptr);
+        };
+        const double ratio = (std::sqrt(5.0) - 1) / 2;
+        double lo = std::log(1e-5), hi = std::log(10.0);
+        for (int iter = 0; iter < 40; iter++)
+        {
+            double a = hi - ratio * (hi - lo);
+            double b = lo + ratio * (hi - lo);
+            if (at(a) < at(b))
+            {
+                hi = b;
+            }
+            else
+            {
+                lo = a;
+            }
+        }
+        best_scale = std::exp((lo + hi) / 2);
+        return at((lo + hi) / 2);
+    }
+
+private:
+    const Dataset &data;
+    ThreadPool &pool;
+};
+
+class NnueTrainer
+{
+public:
+    /**
+    Réseau flottant de même architecture que NnueNetwork (ReLU bornée à [0, 1]),
+    entraîné par mini-lots (Adam) sur la perte logistique, puis quantifié
+    */
+    static constexpr int INPUTS = NnueNetwork::INPUTS;
+    static constexpr int HIDDEN = NnueNetwork::HIDDEN;
+    static constexpr int PARAMS = INPUTS * HIDDEN + 2 * HIDDEN + 1;
+
+    explicit NnueTrainer(uint64_t seed) : params(PARAMS), gradient(PARAMS), m(PARAMS), v(PARAMS)
+    {
+        XorShiftRng rng(seed);
+        for (int k = 0; k < INPUTS * HIDDEN; k++)
+        {
+            params[k] = 0.1f * (rng.below(2001) / 1000.0f - 1.0f);
+        }
+        for (int j = 0; j < HIDDEN; j++)
+        {
+            params[B1 + j] = 0.5f;
+            params[W2 + j] = 0.1f * (rng.below(2001) / 1000.0f - 1.0f);
+        }
+        params[B2] = 0.0f;
+    }
+
+    double train(const Dataset &data, double rate, XorShiftRng &rng)
+    {
+        /**Une époque, positions mélangées; retourne la perte moyenne d'apprentissage*/
+        std::vector<uint32_t> order(data.size());
+        std::iota(order.begin(), order.end(), 0);
+        for (size_t i = order.size(); i > 1; i--)
+        {
+            std::swap(order[i - 1], order[rng.below(static_cast<uint32_t>(i))]);
+        }
+
+        const size_t batch = 256;
+        double total = 0.0;
+        for (size_t begin = 0; begin < order.size(); begin += batch)
+        {
+            size_t end = std::min(order.size(), begin + batch);
+            std::fill(gradient.begin(), gradient.end(), 0.0f);
+            for (size_t i = begin; i < end; i++)
+            {
+                total += backward(data, order[i]);
+            }
+            step(rate, 1.0f / (end - begin));
+        }
+        return total / data.size();
+    }
+
+    double loss(const Dataset &data) const
+    {
+        double total = 0.0;
+        float hidden[HIDDEN];
+        for (size_t k = 0; k < data.size(); k++)
+        {
+            total += logLoss(forward(data, k, hidden), data.labels[k] * 0.5);
+        }
+        return total / data.size();
+    }
+
+    void quantize(NnueNetwork &network) const
+    {
+        /**Poids entiers de nnue.h: W1 et b1 x QA, W2 x QB, b2 x QA x QB (saturés en int16)*/
+        auto to16 = [](double x)
+        {
+            return static_cast<int16_t>(std::max(-32767.0, std::min(32767.0, std::round(x))));
+        };
+        for (int i = 0; i < INPUTS; i++)
+        {
+            for (int j = 0; j < HIDDEN; j++)
+            {
+                network.w1[i][j] = to16(params[i * HIDDEN + j] * NnueNetwork::QA);
+            }
+        }
+        for (int j = 0; j < HIDDEN; j++)
+        {
+            network.b1[j] = to16(params[B1 + j] * NnueNetwork::QA);
+            network.w2[j] = to16(params[W2 + j] * NnueNetwork::QB);
+        }
+        network.b2 = static_cast<int32_t>(std::lround(params[B2] * NnueNetwork::QA * NnueNetwork::QB));
+    }
+
+    static double quantizedLoss(const NnueNetwork &network, const Dataset &data)
+    {
+        /**Perte du réseau quantifié (score / OUTPUT_SCALE = logit), accumulateur rebâti des entrées*/
+        double total = 0.0;
+        for (size_t k = 0; k < data.size(); k++)
+        {
+            NnueAccumulator acc;
+            std::copy(network.b1, network.b1 + HIDDEN, acc.values);
+            for (uint32_t a = data.offsets[k]; a < data.offsets[k + 1]; a++)
+            {
+                for (int j = 0; j < HIDDEN; j++)
+                {
+                    acc.values[j] = static_cast<int16_t>(acc.values[j] + network.w1[data.inputs[a]][j]);
+                }
+            }
+            double z = static_cast<double>(network.output(acc)) / NnueNetwork::OUTPUT_SCALE;
+            total += logLoss(z, data.labels[k] * 0.5);
+        }
+        return total / data.size();
+    }
+
+private:
+    // Rangement de params: W1 [entrée][caché], b1, W2, b2
+    static constexpr int B1 = INPUTS * HIDDEN;
+    static constexpr int W2 = B1 + HIDDEN;
+    static constexpr int B2 = W2 + HIDDEN;
+
+    std::vector<float> params;
+    std::vector<float> gradient;
+    std::vector<float> m, v; // moments d'Adam
+    int t = 0;
+
+    static double logLoss(double z, double y)
+    {
+        // -[y log p + (1 - y) log(1 - p)], p = sigmoid(z), stable quand |z| est grand
+        return std::max(z, 0.0) - z * y + std::log1p(std::exp(-std::fabs(z)));
+    }
+
+    double forward(const Dataset &data, size_t k, float *hidden) const
+    {
+        /**Logit de la position k; hidden reçoit les sommes avant activation*/
+        std::copy(params.begin() + B1, params.begin() + B1 + HIDDEN, hidden);
+        for (uint32_t a = data.offsets[k]; a < data.offsets[k + 1]; a++)
+        {
+            const float *column = &params[data.inputs[a] * HIDDEN];
+            for (int j = 0; j < HIDDEN; j++)
+            {
+                hidden[j] += column[j];
+            }
+        }
+        double z = params[B2];
+        for (int j = 0; j < HIDDEN; j++)
+        {
+            z += params[W2 + j] * std::max(0.0f, std::min(1.0f, hidden[j]));
+        }
+        return z;
+    }
+
+    double backward(const Dataset &data, size_t k)
+    {
+        /**Ajoute le gradient de la position k et retourne sa perte*/
+        float hidden[HIDDEN];
+        double z = forward(data, k, hidden);
+        double y = data.labels[k] * 0.5;
+        float dz = static_cast<float>(1.0 / (1.0 + std::exp(-z)) - y);
+
+        float dh[HIDDEN];
+        for (int j = 0; j < HIDDEN; j++)
+        {
+            float h = std::max(0.0f, std::min(1.0f, hidden[j]));
+            gradient[W2 + j] += dz * h;
+            dh[j] = (hidden[j] > 0.0f && hidden[j] < 1.0f) ? dz * params[W2 + j] : 0.0f;
+            gradient[B1 + j] += dh[j];
+        }
+        gradient[B2] += dz;
+        for (uint32_t a = data.offsets[k]; a < data.offsets[k + 1]; a++)
+        {
+            float *column = &gradient[data.inputs[a] * HIDDEN];
+            for (int j = 0; j < HIDDEN; j++)
+            {
+                column[j] += dh[j];
+            }
+        }
+        return logLoss(z, y);
+    }
+
+    void step(double rate, float scale)
+    {
+        // Adam sur le gradient moyen du mini-lot
+        const float beta1 = 0.9f, beta2 = 0.999f, epsilon = 1e-8f;
+        t++;
+        float correction1 = 1.0f - std::pow(beta1, static_cast<float>(t));
+        float correction2 = 1.0f - std::pow(beta2, static_cast<float>(t));
+        float lr = static_cast<float>(rate);
+        for (int k = 0; k < PARAMS; k++)
+        {
+            float g = gradient[k] * scale;
+            m[k] = beta1 * m[k] + (1 - beta1) * g;
+            v[k] = beta2 * v[k] + (1 - beta2) * g * g;
+            params[k] -= lr * (m[k] / correction1) / (std::sqrt(v[k] / correction2) + epsilon);
+        }
+    }
+};
+
+static int trainNetwork(const std::vector<std::string> &logs, const std::string &out_path, int epochs,
+                        double rate, int skip_plies)
+{
+    /**Mode --nnue: entraîne le réseau de nnue.h et écrit ses poids quantifiés*/
+    Dataset train, validation;
+    train.keep_inputs = validation.keep_inputs = true;
+    long games = 0;
+    for (const std::string &path : logs)
+    {
+        if (!loadGames(path, skip_plies, train, validation, games))
+        {
+            return 1;
+        }
+    }
+    if (train.size() == 0 || validation.size() == 0)
+    {
+        std::cerr << "Pas assez de positions (" << train.size() << " / " << validation.size() << ")" << std::endl;
+        return 1;
+    }
+    std::printf("%ld parties, %zu positions d'apprentissage, %zu de validation, réseau %dx%d\n", games,
+                train.size(), validation.size(), NnueNetwork::INPUTS, NnueNetwork::HIDDEN);
+
+    // Le réseau retenu est celui de la meilleure époque en validation (arrêt précoce)
+    NnueTrainer trainer(0x4E4E5545);
+    NnueTrainer best = trainer;
+    double best_loss = trainer.loss(validation);
+    XorShiftRng rng(0x5EED);
+    for (int epoch = 1; epoch <= epochs; epoch++)
+    {
+        double train_loss = trainer.train(train, rate, rng);
+        double validation_loss = trainer.loss(validation);
+        std::printf("époque %3d  perte %.5f  validation %.5f\n", epoch, train_loss, validation_loss);
+        std::fflush(stdout);
+        if (validation_loss < best_loss)
+        {
+            best_loss = validation_loss;
+            best = trainer;
+        }
+    }
+
+    std::unique_ptr<NnueNetwork> network(new NnueNetwork());
+    best.quantize(*network);
+    std::printf("meilleure époque: perte de validation %.5f\n", best_loss);
+    std::printf("réseau quantifié: perte de validation %.5f\n", NnueTrainer::quantizedLoss(*network, validation));
+    if (!network->save(out_path))
+    {
+        std::cerr << "Écriture impossible: " << out_path << std::endl;
+        return 1;
+    }
+    std::printf("Réseau écrit dans %s\n", out_path.c_str());
+    return 0;
+}
+
+static bool writeHeader(const std::string &path, const int *weights, long games, size_t positions, double train_loss,
+                        double validation_loss)
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        return false;
+    }
+    out << "/**\n"
+        << " * Poids de l'évaluation (Evaluator::evaluateWeights), un entier par caractéristique EvalFeature\n"
+        << " * Fichier généré par tune_eval: ne pas modifier à la main, relancer l'ajustement\n"
+        << " *\n"
+        << " * " << games << " parties, " << positions << " positions d'apprentissage\n";
+    char line[128];
+    std::snprintf(line, sizeof(line), " * perte logistique: apprentissage %.5f, validation %.5f\n", train_loss, validation_loss);
+    out << line << " */\n\n"
+        << "#ifndef EVAL_WEIGHTS_H\n#define EVAL_WEIGHTS_H\n\n"
+        << "const int EVAL_WEIGHTS[] = {\n";
+    for (int k = 0; k < EVAL_FEATURE_COUNT; k++)
+    {
+        std::string value = std::to_string(weights[k]) + ",";
+        std::snprintf(line, sizeof(line), "    %-4s // %s\n", value.c_str(), FEATURE_NAMES[k]);
+        out << line;
+    }
+    out << "};\n\n#endif // EVAL_WEIGHTS_H\n";
+    return static_cast<bool>(out);
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<std::string> inputs;
+    std::string out_path = "eval_weights.h";
+    int iterations = 1000;
+    double rate = 0.01;
+    int threads = 0;
+    int anchor = 100;
+    int skip_plies = 4;
+    std::string nnue_path;
+    int epochs = 20;
+    bool rate_given = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--out" && has_value)
+        {
+            out_path = argv[++i];
+        }
+        else if (arg == "--iterations" && has_value)
+        {
+            iterations = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--rate" && has_value)
+        {
+            rate = std::stod(argv[++i]);
+            rate_given = true;
+        }
+        else if (arg == "--nnue" && has_value)
+        {
+            nnue_path = argv[++i];
+        }
+        else if (arg == "--epochs" && has_value)
+        {
+            epochs = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--threads" && has_value)
+        {
+            threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--anchor" && has_value)
+        {
+            anchor = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--skip-plies" && has_value)
+        {
+            skip_plies = std::max(0, std::stoi(argv[++i]));
+        }
+        else if (!arg.empty() && arg[0] != '-')
+        {
+            inputs.push_back(arg);
+        }
+        else
+        {
+            inputs.clear();
+            break;
+        }
+    }
+    if (inputs.empty())
+    {
+        std::cerr << "Usage: tune_eval games.mlog [autres.mlog ...] [--out eval_weights.h] [--iterations 1000]"
+                  << " [--rate 0.01] [--threads N] [--anchor 100] [--skip-plies 4]" << std::endl;
+        std::cerr << "       tune_eval games.mlog [...] --nnue mancala.nnue [--epochs 20] [--rate 0.001]" << std::endl;
+        return 1;
+    }
+
+    if (!nnue_path.empty())
+    {
+        return trainNetwork(inputs, nnue_path, epochs, rate_given ? rate : 0.001, skip_plies);
+    }
+
+    Dataset train, validation;
+    long games = 0;
+    for (const std::string &path : inputs)
+    {
+        if (!loadGames(path, skip_plies, train, validation, games))
+        {
+            return 1;
+        }
+    }
+    if (train.size() == 0 || validation.size() == 0)
+    {
+        std::cerr << "Pas assez de positions (" << train.size() << " / " << validation.size() << ")" << std::endl;
+        return 1;
+    }
+
+    ThreadPool pool(threads);
+    Tuner tuner(train, pool);
+    Tuner checker(validation, pool);
+    std::printf("%ld parties, %zu positions d'apprentissage, %zu de validation, %d thread(s)\n", games, train.size(),
+                validation.size(), pool.size());
+
+    double scale;
+    double baseline = checker.scaledLoss(EVAL_WEIGHTS, scale);
+    std::printf("poids actuels: perte de validation %.5f (échelle %.5f)\n", baseline, scale);
+
+    // Départ: poids actuels à leur meilleure échelle
+    double w[EVAL_FEATURE_COUNT], m[EVAL_FEATURE_COUNT] = {}, v[EVAL_FEATURE_COUNT] = {};
+    for (int k = 0; k < EVAL_FEATURE_COUNT; k++)
+    {
+        w[k] = EVAL_WEIGHTS[k] * scale;
+    }
+
+    // Adam
+    const double beta1 = 0.9, beta2 = 0.999, epsilon = 1e-8;
+    double gradient[EVAL_FEATURE_COUNT];
+    double train_loss = 0.0;
+    for (int t = 1; t <= iterations; t++)
+    {
+        train_loss = tuner.loss(w, gradient);
+        for (int k = 0; k < EVAL_FEATURE_COUNT; k++)
+        {
+            m[k] = beta1 * m[k] + (1 - beta1) * gradient[k];
+            v[k] = beta2 * v[k] + (1 - beta2) * gradient[k] * gradient[k];
+            double m_hat = m[k] / (1 - std::pow(beta1, t));
+            double v_hat = v[k] / (1 - std::pow(beta2, t));
+            w[k] -= rate * m_hat / (std::sqrt(v_hat) + epsilon);
+        }
+        if (t % 100 == 0 || t == iterations)
+        {
+            std::printf("itération %5d  perte %.5f  validation %.5f\n", t, train_loss, checker.loss(w, nullptr));
+            std::fflush(stdout);
+        }
+    }
+
+    if (w[EVAL_CAPTURED] <= 0)
+    {
+        std::cerr << "Poids des graines capturées non positif: ajustement rejeté" << std::endl;
+        return 1;
+    }
+
+    int weights[EVAL_FEATURE_COUNT];
+    for (int k = 0; k < EVAL_FEATURE_COUNT; k++)
+    {
+        weights[k] = static_cast<int>(std::lround(w[k] / w[EVAL_CAPTURED] * anchor));
+        std::printf("%-24s %10.5f  -> %d\n", FEATURE_NAMES[k], w[k], weights[k]);
+    }
+
+    double tuned = checker.scaledLoss(weights, scale);
+    std::printf("poids entiers: perte de validation %.5f (avant: %.5f)\n", tuned, baseline);
+
+    if (!writeHeader(out_path, weights, games, train.size(), train_loss, tuned))
+    {
+        std::cerr << "Écriture impossible: " << out_path << std::endl;
+        return 1;
+    }
+    std::printf("Poids écrits dans %s\n", out_path.c_str());
+    return 0;
+}